@@ -0,0 +1,1126 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapemeshes.cpp
+// ============
+// create meshes for various 3D primitives: plane, pyramid, cube, cone,
+// cylinder, prism, sphere, tapered cylinder, torus
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeMeshes.h"
+#include "FrameProfiler.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+// declare the constants used for generating the shape meshes
+namespace
+{
+	// number of segments used for the shapes of revolution
+	const int g_CircleSegments = 30;
+
+	// tessellation divisions per LOD level for the curved
+	// shapes - the high level matches the original fixed
+	// tessellation
+	const int g_LODDivisions[ShapeMeshes::TOTAL_MESH_LODS] = { 30, 16, 8 };
+
+	// number of floats per interleaved vertex:
+	// position (3) + normal (3) + texture coordinate (2)
+	const GLuint g_FloatsPerVertex = 8;
+
+	// capacity of one instance streaming region - sized well
+	// above the retained scene's total instance count
+	const GLuint g_MaxStreamedInstances = 1024;
+
+	// capacity of one indirect command streaming region -
+	// one command per draw batch, so this is generous
+	const GLuint g_MaxIndirectCommands = 256;
+
+	// vertex buffer binding index for the per-instance
+	// attributes - kept clear of the bindings the per-vertex
+	// attribute pointers assign implicitly
+	const GLuint g_InstanceAttribBinding = 7;
+}
+
+/***********************************************************
+ *  ShapeMeshes()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShapeMeshes::ShapeMeshes()
+{
+	m_BoxMesh.bLoaded = false;
+	m_ConeMesh.bLoaded = false;
+	m_PlaneMesh.bLoaded = false;
+	m_PrismMesh.bLoaded = false;
+	m_Pyramid4Mesh.bLoaded = false;
+	m_TaperedCylinderMesh.bLoaded = false;
+	for (int lod = 0; lod < TOTAL_MESH_LODS; lod++)
+	{
+		m_CylinderMeshLODs[lod].bLoaded = false;
+		m_SphereMeshLODs[lod].bLoaded = false;
+		m_TorusMeshLODs[lod].bLoaded = false;
+	}
+	m_sharedVAO = 0;
+	m_sharedVBO = 0;
+	m_sharedIBO = 0;
+	m_instanceVBO = 0;
+	m_indirectBuffer = 0;
+	m_bBuffersDirty = false;
+	m_instanceStreamPtr = NULL;
+	m_indirectStreamPtr = NULL;
+	m_streamRegion = 0;
+	m_streamCursor = 0;
+	for (int region = 0; region < InstanceStreamRegions; region++)
+	{
+		m_streamFences[region] = NULL;
+	}
+}
+
+/***********************************************************
+ *  ~ShapeMeshes()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShapeMeshes::~ShapeMeshes()
+{
+	// free the shared vertex array and mega-buffers that
+	// hold the data for all of the loaded meshes
+	if (0 != m_sharedVAO)
+	{
+		glDeleteVertexArrays(1, &m_sharedVAO);
+		glDeleteBuffers(1, &m_sharedVBO);
+		glDeleteBuffers(1, &m_sharedIBO);
+		m_sharedVAO = 0;
+		m_sharedVBO = 0;
+		m_sharedIBO = 0;
+	}
+	// release the persistent mapping and free the shared
+	// instance streaming buffer
+	if (NULL != m_instanceStreamPtr)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_instanceStreamPtr = NULL;
+	}
+	if (0 != m_instanceVBO)
+	{
+		glDeleteBuffers(1, &m_instanceVBO);
+		m_instanceVBO = 0;
+	}
+	// release the persistent mapping and free the indirect
+	// command streaming buffer
+	if (NULL != m_indirectStreamPtr)
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+		glUnmapBuffer(GL_DRAW_INDIRECT_BUFFER);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		m_indirectStreamPtr = NULL;
+	}
+	if (0 != m_indirectBuffer)
+	{
+		glDeleteBuffers(1, &m_indirectBuffer);
+		m_indirectBuffer = 0;
+	}
+	// free any outstanding streaming region fences
+	for (int region = 0; region < InstanceStreamRegions; region++)
+	{
+		if (NULL != m_streamFences[region])
+		{
+			glDeleteSync(m_streamFences[region]);
+			m_streamFences[region] = NULL;
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadMesh()
+ *
+ *  This method is used for appending the passed in vertex
+ *  and index data to the staged mega-buffer data, and for
+ *  recording where the mesh landed within it.  The staged
+ *  data is uploaded in one pass by BindMeshBuffers().
+ ***********************************************************/
+void ShapeMeshes::LoadMesh(
+	GLMesh& mesh,
+	const std::vector<MeshVertex>& vertices,
+	const std::vector<unsigned int>& indices)
+{
+	if (mesh.bLoaded)
+	{
+		return;
+	}
+
+	// record where the mesh lands within the shared buffers -
+	// the indices stay zero-based, the draw calls apply the
+	// base vertex offset
+	mesh.baseVertex = (GLint)m_stagedVertices.size();
+	mesh.indexOffset = (GLuint)(m_stagedIndices.size() * sizeof(unsigned int));
+	mesh.nIndices = (GLuint)indices.size();
+
+	m_stagedVertices.insert(m_stagedVertices.end(),
+		vertices.begin(), vertices.end());
+	m_stagedIndices.insert(m_stagedIndices.end(),
+		indices.begin(), indices.end());
+
+	m_bBuffersDirty = true;
+	mesh.bLoaded = true;
+}
+
+/***********************************************************
+ *  BindMeshBuffers()
+ *
+ *  This method is used for uploading any newly staged mesh
+ *  data into the shared mega-buffers and binding the shared
+ *  vertex array.  It is called once per frame before the
+ *  draw methods, which then submit with base-vertex offsets
+ *  and no buffer rebinding.
+ ***********************************************************/
+void ShapeMeshes::BindMeshBuffers()
+{
+	// create the shared vertex array, the mega-buffers and
+	// the instance buffer on the first call and configure
+	// the vertex attribute layout once
+	if (0 == m_sharedVAO)
+	{
+		glGenVertexArrays(1, &m_sharedVAO);
+		glGenBuffers(1, &m_sharedVBO);
+		glGenBuffers(1, &m_sharedIBO);
+		glGenBuffers(1, &m_instanceVBO);
+		glGenBuffers(1, &m_indirectBuffer);
+
+		glBindVertexArray(m_sharedVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_sharedVBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_sharedIBO);
+
+		// position attribute
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+			sizeof(MeshVertex), (void*)offsetof(MeshVertex, position));
+		// normal attribute
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
+			sizeof(MeshVertex), (void*)offsetof(MeshVertex, normal));
+		// texture coordinate attribute
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE,
+			sizeof(MeshVertex), (void*)offsetof(MeshVertex, uv));
+
+		// the instance buffer is created with immutable storage,
+		// persistently mapped and split into rotating regions -
+		// the CPU writes one region while the GPU reads another,
+		// so streaming the per-frame instance data needs no
+		// driver round-trip at all
+		glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+		GLsizeiptr regionBytes = g_MaxStreamedInstances * sizeof(INSTANCE_DATA);
+		glBufferStorage(GL_ARRAY_BUFFER,
+			regionBytes * InstanceStreamRegions, NULL,
+			GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+		m_instanceStreamPtr = (INSTANCE_DATA*)glMapBufferRange(
+			GL_ARRAY_BUFFER, 0, regionBytes * InstanceStreamRegions,
+			GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+		// the indirect command buffer is streamed the same way -
+		// persistently mapped rotating regions guarded by the
+		// per-region fences below
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+		GLsizeiptr commandRegionBytes =
+			g_MaxIndirectCommands * sizeof(DRAW_INDIRECT_COMMAND);
+		glBufferStorage(GL_DRAW_INDIRECT_BUFFER,
+			commandRegionBytes * InstanceStreamRegions, NULL,
+			GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+		m_indirectStreamPtr = (DRAW_INDIRECT_COMMAND*)glMapBufferRange(
+			GL_DRAW_INDIRECT_BUFFER, 0, commandRegionBytes * InstanceStreamRegions,
+			GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+		// per-instance attributes, advancing once per instance -
+		// the model matrix occupies four consecutive attribute
+		// locations, followed by the material table index.  The
+		// attributes read through a separate binding index bound
+		// at the start of the buffer - the indirect commands
+		// address into it with their base instance
+		for (int column = 0; column < 4; column++)
+		{
+			glEnableVertexAttribArray(3 + column);
+			glVertexAttribFormat(3 + column, 4, GL_FLOAT, GL_FALSE,
+				(GLuint)(offsetof(INSTANCE_DATA, modelMatrix) + column * sizeof(glm::vec4)));
+			glVertexAttribBinding(3 + column, g_InstanceAttribBinding);
+		}
+		glEnableVertexAttribArray(7);
+		glVertexAttribIFormat(7, 1, GL_INT,
+			(GLuint)offsetof(INSTANCE_DATA, materialIndex));
+		glVertexAttribBinding(7, g_InstanceAttribBinding);
+		glEnableVertexAttribArray(8);
+		glVertexAttribIFormat(8, 1, GL_INT,
+			(GLuint)offsetof(INSTANCE_DATA, stateIndex));
+		glVertexAttribBinding(8, g_InstanceAttribBinding);
+		glVertexBindingDivisor(g_InstanceAttribBinding, 1);
+		glBindVertexBuffer(g_InstanceAttribBinding, m_instanceVBO,
+			0, sizeof(INSTANCE_DATA));
+	}
+
+	// upload the staged vertex and index data in one pass
+	// when any mesh has been loaded since the last upload
+	if (m_bBuffersDirty)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_sharedVBO);
+		glBufferData(GL_ARRAY_BUFFER,
+			m_stagedVertices.size() * sizeof(MeshVertex),
+			m_stagedVertices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_sharedIBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+			m_stagedIndices.size() * sizeof(unsigned int),
+			m_stagedIndices.data(), GL_STATIC_DRAW);
+		m_bBuffersDirty = false;
+	}
+
+	// fence the streaming region the previous frame wrote and
+	// rotate to the next one - the wait only ever triggers when
+	// the GPU has fallen a full rotation behind the CPU
+	if (NULL != m_streamFences[m_streamRegion])
+	{
+		glDeleteSync(m_streamFences[m_streamRegion]);
+	}
+	m_streamFences[m_streamRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_streamRegion = (m_streamRegion + 1) % InstanceStreamRegions;
+	if (NULL != m_streamFences[m_streamRegion])
+	{
+		glClientWaitSync(m_streamFences[m_streamRegion],
+			GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+		glDeleteSync(m_streamFences[m_streamRegion]);
+		m_streamFences[m_streamRegion] = NULL;
+	}
+	m_streamCursor = 0;
+	m_stagedCommands.clear();
+
+	glBindVertexArray(m_sharedVAO);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+}
+
+/***********************************************************
+ *  QueueMesh()
+ *
+ *  This method is used for queueing one indirect draw
+ *  command for a loaded mesh into the current frame.  The
+ *  per-draw state index travels with the staged instance
+ *  data, so the commands can be queued in any order.
+ ***********************************************************/
+void ShapeMeshes::QueueMesh(const GLMesh& mesh, int instanceCount, GLuint baseInstance)
+{
+	DRAW_INDIRECT_COMMAND command = {};
+
+	if (!mesh.bLoaded || (instanceCount <= 0))
+	{
+		return;
+	}
+
+	command.count = mesh.nIndices;
+	command.instanceCount = (GLuint)instanceCount;
+	// the mesh records a byte offset, the command wants an
+	// index count offset
+	command.firstIndex = mesh.indexOffset / (GLuint)sizeof(unsigned int);
+	command.baseVertex = mesh.baseVertex;
+	command.baseInstance = baseInstance;
+
+	m_stagedCommands.push_back(command);
+}
+
+/***********************************************************
+ *  SubmitIndirectFrame()
+ *
+ *  This method is used for submitting every queued command
+ *  for the frame with a single multi-draw-indirect call.
+ *  The commands are written into the current persistently
+ *  mapped streaming region and the GPU reads them straight
+ *  out of the indirect buffer - the whole frame costs one
+ *  driver call regardless of how many draws it holds.
+ ***********************************************************/
+void ShapeMeshes::SubmitIndirectFrame()
+{
+	if ((NULL == m_indirectStreamPtr) || m_stagedCommands.empty())
+	{
+		return;
+	}
+	// the region capacity is sized well above the retained
+	// scene's batch count - an overflowing frame is dropped
+	// rather than overwriting commands the GPU is reading
+	if ((GLuint)m_stagedCommands.size() > g_MaxIndirectCommands)
+	{
+		return;
+	}
+
+	GLuint commandBase = m_streamRegion * g_MaxIndirectCommands;
+	memcpy(&m_indirectStreamPtr[commandBase], m_stagedCommands.data(),
+		m_stagedCommands.size() * sizeof(DRAW_INDIRECT_COMMAND));
+
+	FrameProfiler::CountDrawCall();
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+		(void*)(size_t)(commandBase * sizeof(DRAW_INDIRECT_COMMAND)),
+		(GLsizei)m_stagedCommands.size(), 0);
+}
+
+/***********************************************************
+ *  SetInstanceData()
+ *
+ *  This method is used for staging the per-instance data
+ *  into the shared instance buffer for one queued draw.
+ *  The data is written straight into the current
+ *  persistently mapped streaming region - one coherent
+ *  write instead of a buffer upload through the driver.
+ *  Returns the base instance index the queued command must
+ *  carry to address its data within the buffer.
+ ***********************************************************/
+GLuint ShapeMeshes::SetInstanceData(const std::vector<INSTANCE_DATA>& instances)
+{
+	if (NULL == m_instanceStreamPtr)
+	{
+		return(0);
+	}
+	// the region capacity is sized well above the retained
+	// scene - anything past it is dropped rather than
+	// overwriting instance data still being read by the GPU
+	if ((m_streamCursor + (GLuint)instances.size()) > g_MaxStreamedInstances)
+	{
+		return(0);
+	}
+
+	GLuint baseInstance = m_streamRegion * g_MaxStreamedInstances + m_streamCursor;
+	memcpy(&m_instanceStreamPtr[baseInstance], instances.data(),
+		instances.size() * sizeof(INSTANCE_DATA));
+	m_streamCursor += (GLuint)instances.size();
+	return(baseInstance);
+}
+
+/***********************************************************
+ *  BuildRevolvedSides()
+ *
+ *  This method is used for appending the side wall vertex
+ *  and triangle data for the cylinder family of shapes.
+ *  The wall runs from the bottom radius at y=0.0 up to the
+ *  top radius at y=1.0.
+ ***********************************************************/
+void ShapeMeshes::BuildRevolvedSides(
+	std::vector<MeshVertex>& vertices,
+	std::vector<unsigned int>& indices,
+	float bottomRadius,
+	float topRadius,
+	int segments)
+{
+	const unsigned int baseIndex = (unsigned int)vertices.size();
+	const float twoPi = glm::two_pi<float>();
+	// the slope of the wall determines the y component of
+	// the surface normal for non-vertical walls
+	const float slope = bottomRadius - topRadius;
+
+	// one extra column of vertices is generated so the
+	// texture coordinates can wrap cleanly at the seam
+	for (int segment = 0; segment <= segments; segment++)
+	{
+		float angle = twoPi * (float)segment / (float)segments;
+		float x = cos(angle);
+		float z = sin(angle);
+		glm::vec3 normal = glm::normalize(glm::vec3(x, slope, z));
+		float u = (float)segment / (float)segments;
+
+		MeshVertex bottomVertex;
+		bottomVertex.position = glm::vec3(x * bottomRadius, 0.0f, z * bottomRadius);
+		bottomVertex.normal = normal;
+		bottomVertex.uv = glm::vec2(u, 0.0f);
+		vertices.push_back(bottomVertex);
+
+		MeshVertex topVertex;
+		topVertex.position = glm::vec3(x * topRadius, 1.0f, z * topRadius);
+		topVertex.normal = normal;
+		topVertex.uv = glm::vec2(u, 1.0f);
+		vertices.push_back(topVertex);
+	}
+
+	// two triangles per wall segment
+	for (int segment = 0; segment < segments; segment++)
+	{
+		unsigned int bottomLeft = baseIndex + segment * 2;
+		unsigned int topLeft = bottomLeft + 1;
+		unsigned int bottomRight = bottomLeft + 2;
+		unsigned int topRight = bottomLeft + 3;
+
+		indices.push_back(bottomLeft);
+		indices.push_back(topLeft);
+		indices.push_back(bottomRight);
+		indices.push_back(bottomRight);
+		indices.push_back(topLeft);
+		indices.push_back(topRight);
+	}
+}
+
+/***********************************************************
+ *  BuildCapDisc()
+ *
+ *  This method is used for appending a horizontal cap disc
+ *  at the given height for the cylinder family of shapes.
+ ***********************************************************/
+void ShapeMeshes::BuildCapDisc(
+	std::vector<MeshVertex>& vertices,
+	std::vector<unsigned int>& indices,
+	float radius,
+	float height,
+	bool bFacingUp,
+	int segments)
+{
+	const unsigned int baseIndex = (unsigned int)vertices.size();
+	const float twoPi = glm::two_pi<float>();
+	glm::vec3 normal = glm::vec3(0.0f, bFacingUp ? 1.0f : -1.0f, 0.0f);
+
+	// the center vertex of the disc
+	MeshVertex centerVertex;
+	centerVertex.position = glm::vec3(0.0f, height, 0.0f);
+	centerVertex.normal = normal;
+	centerVertex.uv = glm::vec2(0.5f, 0.5f);
+	vertices.push_back(centerVertex);
+
+	// the ring of vertices around the edge of the disc
+	for (int segment = 0; segment <= segments; segment++)
+	{
+		float angle = twoPi * (float)segment / (float)segments;
+		float x = cos(angle);
+		float z = sin(angle);
+
+		MeshVertex edgeVertex;
+		edgeVertex.position = glm::vec3(x * radius, height, z * radius);
+		edgeVertex.normal = normal;
+		edgeVertex.uv = glm::vec2(x * 0.5f + 0.5f, z * 0.5f + 0.5f);
+		vertices.push_back(edgeVertex);
+	}
+
+	// a fan of triangles from the center to the edge ring,
+	// wound so the visible face matches the normal direction
+	for (int segment = 0; segment < segments; segment++)
+	{
+		indices.push_back(baseIndex);
+		if (bFacingUp)
+		{
+			indices.push_back(baseIndex + 1 + segment + 1);
+			indices.push_back(baseIndex + 1 + segment);
+		}
+		else
+		{
+			indices.push_back(baseIndex + 1 + segment);
+			indices.push_back(baseIndex + 1 + segment + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadBoxMesh()
+ *
+ *  This method is used for loading the unit box mesh into
+ *  memory.  The box is centered on the origin with sides
+ *  of length 1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadBoxMesh()
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	// the six face normals of the box
+	const glm::vec3 faceNormals[6] =
+	{
+		glm::vec3(0.0f, 0.0f, 1.0f),   // front
+		glm::vec3(0.0f, 0.0f, -1.0f),  // back
+		glm::vec3(1.0f, 0.0f, 0.0f),   // right
+		glm::vec3(-1.0f, 0.0f, 0.0f),  // left
+		glm::vec3(0.0f, 1.0f, 0.0f),   // top
+		glm::vec3(0.0f, -1.0f, 0.0f)   // bottom
+	};
+
+	// four unique vertices per face so each face can carry
+	// its own normal and texture coordinates
+	for (int face = 0; face < 6; face++)
+	{
+		glm::vec3 normal = faceNormals[face];
+		// derive the two in-plane axes for the face
+		glm::vec3 up = (fabs(normal.y) > 0.5f) ?
+			glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		glm::vec3 right = glm::normalize(glm::cross(up, normal));
+		up = glm::cross(normal, right);
+
+		unsigned int baseIndex = (unsigned int)vertices.size();
+		for (int corner = 0; corner < 4; corner++)
+		{
+			float s = (corner == 1 || corner == 2) ? 0.5f : -0.5f;
+			float t = (corner >= 2) ? 0.5f : -0.5f;
+
+			MeshVertex vertex;
+			vertex.position = normal * 0.5f + right * s + up * t;
+			vertex.normal = normal;
+			vertex.uv = glm::vec2(s + 0.5f, t + 0.5f);
+			vertices.push_back(vertex);
+		}
+
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + 1);
+		indices.push_back(baseIndex + 2);
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + 2);
+		indices.push_back(baseIndex + 3);
+	}
+
+	LoadMesh(m_BoxMesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadConeMesh()
+ *
+ *  This method is used for loading the cone mesh into
+ *  memory.  The cone base has a radius of 1.0 at y=0.0
+ *  with the point at y=1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadConeMesh()
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	BuildRevolvedSides(vertices, indices, 1.0f, 0.0f, g_CircleSegments);
+	BuildCapDisc(vertices, indices, 1.0f, 0.0f, false, g_CircleSegments);
+
+	LoadMesh(m_ConeMesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadCylinderMesh()
+ *
+ *  This method is used for loading the cylinder mesh into
+ *  memory at every tessellation level.  The cylinder has a
+ *  radius of 1.0 with the base at y=0.0 and the top at
+ *  y=1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadCylinderMesh()
+{
+	for (int lod = 0; lod < TOTAL_MESH_LODS; lod++)
+	{
+		std::vector<MeshVertex> vertices;
+		std::vector<unsigned int> indices;
+
+		BuildCylinderLOD(vertices, indices, g_LODDivisions[lod]);
+		LoadMesh(m_CylinderMeshLODs[lod], vertices, indices);
+	}
+}
+
+/***********************************************************
+ *  BuildCylinderLOD()
+ *
+ *  This method generates the cylinder vertex data at the
+ *  passed in tessellation level.  It does no OpenGL work,
+ *  so it is safe to call from worker threads.
+ ***********************************************************/
+void ShapeMeshes::BuildCylinderLOD(
+	std::vector<MeshVertex>& vertices,
+	std::vector<unsigned int>& indices,
+	int segments)
+{
+	BuildRevolvedSides(vertices, indices, 1.0f, 1.0f, segments);
+	BuildCapDisc(vertices, indices, 1.0f, 0.0f, false, segments);
+	BuildCapDisc(vertices, indices, 1.0f, 1.0f, true, segments);
+}
+
+/***********************************************************
+ *  LoadPlaneMesh()
+ *
+ *  This method is used for loading the plane mesh into
+ *  memory.  The plane lies in the XZ plane at y=0.0 and
+ *  extends from -1.0 to 1.0 on both axes.
+ ***********************************************************/
+void ShapeMeshes::LoadPlaneMesh()
+{
+	std::vector<MeshVertex> vertices(4);
+	std::vector<unsigned int> indices;
+
+	vertices[0].position = glm::vec3(-1.0f, 0.0f, 1.0f);
+	vertices[0].uv = glm::vec2(0.0f, 0.0f);
+	vertices[1].position = glm::vec3(1.0f, 0.0f, 1.0f);
+	vertices[1].uv = glm::vec2(1.0f, 0.0f);
+	vertices[2].position = glm::vec3(1.0f, 0.0f, -1.0f);
+	vertices[2].uv = glm::vec2(1.0f, 1.0f);
+	vertices[3].position = glm::vec3(-1.0f, 0.0f, -1.0f);
+	vertices[3].uv = glm::vec2(0.0f, 1.0f);
+	for (int i = 0; i < 4; i++)
+	{
+		vertices[i].normal = glm::vec3(0.0f, 1.0f, 0.0f);
+	}
+
+	indices.push_back(0);
+	indices.push_back(1);
+	indices.push_back(2);
+	indices.push_back(0);
+	indices.push_back(2);
+	indices.push_back(3);
+
+	LoadMesh(m_PlaneMesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadPrismMesh()
+ *
+ *  This method is used for loading the triangular prism
+ *  mesh into memory.  The prism is centered on the origin
+ *  with a height and width of 1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadPrismMesh()
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	// the three corners of the triangular cross section
+	const glm::vec3 corners[3] =
+	{
+		glm::vec3(-0.5f, -0.5f, 0.0f),
+		glm::vec3(0.5f, -0.5f, 0.0f),
+		glm::vec3(0.0f, 0.5f, 0.0f)
+	};
+
+	// the two triangular end faces at z=-0.5 and z=0.5
+	for (int end = 0; end < 2; end++)
+	{
+		float z = (end == 0) ? 0.5f : -0.5f;
+		glm::vec3 normal = glm::vec3(0.0f, 0.0f, (end == 0) ? 1.0f : -1.0f);
+		unsigned int baseIndex = (unsigned int)vertices.size();
+
+		for (int corner = 0; corner < 3; corner++)
+		{
+			MeshVertex vertex;
+			vertex.position = glm::vec3(corners[corner].x, corners[corner].y, z);
+			vertex.normal = normal;
+			vertex.uv = glm::vec2(corners[corner].x + 0.5f, corners[corner].y + 0.5f);
+			vertices.push_back(vertex);
+		}
+
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + (end == 0 ? 1 : 2));
+		indices.push_back(baseIndex + (end == 0 ? 2 : 1));
+	}
+
+	// the three rectangular side faces
+	for (int side = 0; side < 3; side++)
+	{
+		glm::vec3 cornerA = corners[side];
+		glm::vec3 cornerB = corners[(side + 1) % 3];
+		glm::vec3 edge = cornerB - cornerA;
+		glm::vec3 normal = glm::normalize(glm::vec3(edge.y, -edge.x, 0.0f));
+		unsigned int baseIndex = (unsigned int)vertices.size();
+
+		for (int corner = 0; corner < 4; corner++)
+		{
+			glm::vec3 position = (corner == 0 || corner == 3) ? cornerA : cornerB;
+			position.z = (corner < 2) ? 0.5f : -0.5f;
+
+			MeshVertex vertex;
+			vertex.position = position;
+			vertex.normal = normal;
+			vertex.uv = glm::vec2((corner == 0 || corner == 3) ? 0.0f : 1.0f,
+				(corner < 2) ? 0.0f : 1.0f);
+			vertices.push_back(vertex);
+		}
+
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + 1);
+		indices.push_back(baseIndex + 2);
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + 2);
+		indices.push_back(baseIndex + 3);
+	}
+
+	LoadMesh(m_PrismMesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadPyramid4Mesh()
+ *
+ *  This method is used for loading the four-sided pyramid
+ *  mesh into memory.  The pyramid is centered on the origin
+ *  with a height and base width of 1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadPyramid4Mesh()
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	const glm::vec3 apex = glm::vec3(0.0f, 0.5f, 0.0f);
+	// the four corners of the square base, wound counter-
+	// clockwise when viewed from above
+	const glm::vec3 baseCorners[4] =
+	{
+		glm::vec3(-0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, 0.5f),
+		glm::vec3(0.5f, -0.5f, -0.5f),
+		glm::vec3(-0.5f, -0.5f, -0.5f)
+	};
+
+	// the four triangular side faces
+	for (int side = 0; side < 4; side++)
+	{
+		glm::vec3 cornerA = baseCorners[side];
+		glm::vec3 cornerB = baseCorners[(side + 1) % 4];
+		glm::vec3 normal = glm::normalize(
+			glm::cross(cornerB - cornerA, apex - cornerA));
+		unsigned int baseIndex = (unsigned int)vertices.size();
+
+		MeshVertex vertexA;
+		vertexA.position = cornerA;
+		vertexA.normal = normal;
+		vertexA.uv = glm::vec2(0.0f, 0.0f);
+		vertices.push_back(vertexA);
+
+		MeshVertex vertexB;
+		vertexB.position = cornerB;
+		vertexB.normal = normal;
+		vertexB.uv = glm::vec2(1.0f, 0.0f);
+		vertices.push_back(vertexB);
+
+		MeshVertex vertexApex;
+		vertexApex.position = apex;
+		vertexApex.normal = normal;
+		vertexApex.uv = glm::vec2(0.5f, 1.0f);
+		vertices.push_back(vertexApex);
+
+		indices.push_back(baseIndex);
+		indices.push_back(baseIndex + 1);
+		indices.push_back(baseIndex + 2);
+	}
+
+	// the square base face, facing downward
+	unsigned int baseIndex = (unsigned int)vertices.size();
+	for (int corner = 0; corner < 4; corner++)
+	{
+		MeshVertex vertex;
+		vertex.position = baseCorners[corner];
+		vertex.normal = glm::vec3(0.0f, -1.0f, 0.0f);
+		vertex.uv = glm::vec2(baseCorners[corner].x + 0.5f,
+			baseCorners[corner].z + 0.5f);
+		vertices.push_back(vertex);
+	}
+	indices.push_back(baseIndex);
+	indices.push_back(baseIndex + 2);
+	indices.push_back(baseIndex + 1);
+	indices.push_back(baseIndex);
+	indices.push_back(baseIndex + 3);
+	indices.push_back(baseIndex + 2);
+
+	LoadMesh(m_Pyramid4Mesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadSphereMesh()
+ *
+ *  This method is used for loading the sphere mesh into
+ *  memory at every tessellation level.  The sphere is
+ *  centered on the origin with a radius of 1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadSphereMesh()
+{
+	for (int lod = 0; lod < TOTAL_MESH_LODS; lod++)
+	{
+		std::vector<MeshVertex> vertices;
+		std::vector<unsigned int> indices;
+
+		BuildSphereLOD(vertices, indices, g_LODDivisions[lod]);
+		LoadMesh(m_SphereMeshLODs[lod], vertices, indices);
+	}
+}
+
+/***********************************************************
+ *  BuildSphereLOD()
+ *
+ *  This method generates the sphere vertex data at the
+ *  passed in tessellation level.  It does no OpenGL work,
+ *  so it is safe to call from worker threads.
+ ***********************************************************/
+void ShapeMeshes::BuildSphereLOD(
+	std::vector<MeshVertex>& vertices,
+	std::vector<unsigned int>& indices,
+	int divisions)
+{
+	const float pi = glm::pi<float>();
+	const float twoPi = glm::two_pi<float>();
+
+	// generate the latitude/longitude grid of vertices -
+	// on a unit sphere the position doubles as the normal
+	for (int latitude = 0; latitude <= divisions; latitude++)
+	{
+		float theta = pi * (float)latitude / (float)divisions;
+		float y = cos(theta);
+		float ringRadius = sin(theta);
+
+		for (int longitude = 0; longitude <= divisions; longitude++)
+		{
+			float phi = twoPi * (float)longitude / (float)divisions;
+			float x = ringRadius * cos(phi);
+			float z = ringRadius * sin(phi);
+
+			MeshVertex vertex;
+			vertex.position = glm::vec3(x, y, z);
+			vertex.normal = glm::vec3(x, y, z);
+			vertex.uv = glm::vec2(
+				(float)longitude / (float)divisions,
+				1.0f - (float)latitude / (float)divisions);
+			vertices.push_back(vertex);
+		}
+	}
+
+	// two triangles per grid cell
+	for (int latitude = 0; latitude < divisions; latitude++)
+	{
+		for (int longitude = 0; longitude < divisions; longitude++)
+		{
+			unsigned int first = latitude * (divisions + 1) + longitude;
+			unsigned int second = first + divisions + 1;
+
+			indices.push_back(first);
+			indices.push_back(second);
+			indices.push_back(first + 1);
+			indices.push_back(second);
+			indices.push_back(second + 1);
+			indices.push_back(first + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadTaperedCylinderMesh()
+ *
+ *  This method is used for loading the tapered cylinder
+ *  mesh into memory.  The bottom radius is 1.0 at y=0.0,
+ *  tapering to a radius of 0.5 at y=1.0.
+ ***********************************************************/
+void ShapeMeshes::LoadTaperedCylinderMesh()
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+
+	BuildRevolvedSides(vertices, indices, 1.0f, 0.5f, g_CircleSegments);
+	BuildCapDisc(vertices, indices, 1.0f, 0.0f, false, g_CircleSegments);
+	BuildCapDisc(vertices, indices, 0.5f, 1.0f, true, g_CircleSegments);
+
+	LoadMesh(m_TaperedCylinderMesh, vertices, indices);
+}
+
+/***********************************************************
+ *  LoadTorusMesh()
+ *
+ *  This method is used for loading the torus mesh into
+ *  memory at every tessellation level.  The torus is
+ *  centered on the origin in the XY plane with a ring
+ *  radius of 1.0 and the passed in tube thickness.
+ ***********************************************************/
+void ShapeMeshes::LoadTorusMesh(float thickness)
+{
+	for (int lod = 0; lod < TOTAL_MESH_LODS; lod++)
+	{
+		std::vector<MeshVertex> vertices;
+		std::vector<unsigned int> indices;
+
+		BuildTorusLOD(vertices, indices, g_LODDivisions[lod], thickness);
+		LoadMesh(m_TorusMeshLODs[lod], vertices, indices);
+	}
+}
+
+/***********************************************************
+ *  BuildTorusLOD()
+ *
+ *  This method generates the torus vertex data at the
+ *  passed in tessellation level.  It does no OpenGL work,
+ *  so it is safe to call from worker threads.
+ ***********************************************************/
+void ShapeMeshes::BuildTorusLOD(
+	std::vector<MeshVertex>& vertices,
+	std::vector<unsigned int>& indices,
+	int divisions,
+	float thickness)
+{
+	const float twoPi = glm::two_pi<float>();
+
+	// generate the grid of vertices around the ring and
+	// around the tube cross section
+	for (int ring = 0; ring <= divisions; ring++)
+	{
+		float ringAngle = twoPi * (float)ring / (float)divisions;
+		glm::vec3 ringCenter = glm::vec3(
+			cos(ringAngle), sin(ringAngle), 0.0f);
+
+		for (int tube = 0; tube <= divisions; tube++)
+		{
+			float tubeAngle = twoPi * (float)tube / (float)divisions;
+			// the outward direction from the ring center
+			glm::vec3 outward = ringCenter * cos(tubeAngle) +
+				glm::vec3(0.0f, 0.0f, 1.0f) * sin(tubeAngle);
+
+			MeshVertex vertex;
+			vertex.position = ringCenter + outward * thickness;
+			vertex.normal = outward;
+			vertex.uv = glm::vec2(
+				(float)ring / (float)divisions,
+				(float)tube / (float)divisions);
+			vertices.push_back(vertex);
+		}
+	}
+
+	// two triangles per grid cell
+	for (int ring = 0; ring < divisions; ring++)
+	{
+		for (int tube = 0; tube < divisions; tube++)
+		{
+			unsigned int first = ring * (divisions + 1) + tube;
+			unsigned int second = first + divisions + 1;
+
+			indices.push_back(first);
+			indices.push_back(second);
+			indices.push_back(first + 1);
+			indices.push_back(second);
+			indices.push_back(second + 1);
+			indices.push_back(first + 1);
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadAllMeshes()
+ *
+ *  This method loads every shape mesh.  The tessellated
+ *  curved meshes - cylinder, sphere and torus at all three
+ *  LOD levels - are generated on worker threads, mirroring
+ *  the texture decode pool: the generation is pure CPU work
+ *  and only the appends into the shared staging buffers run
+ *  on the calling thread.  The cheap analytic meshes are
+ *  built on the calling thread while the workers run, and
+ *  the appends happen in a fixed order so the shared-buffer
+ *  layout stays deterministic run over run.
+ ***********************************************************/
+void ShapeMeshes::LoadAllMeshes()
+{
+	// one generation task per curved mesh per LOD level
+	struct MESH_BUILD
+	{
+		GLMesh* pTargetMesh;
+		std::vector<MeshVertex> vertices;
+		std::vector<unsigned int> indices;
+	};
+	const int totalBuilds = 3 * TOTAL_MESH_LODS;
+	MESH_BUILD builds[3 * TOTAL_MESH_LODS];
+	std::vector<std::thread> workers;
+	std::atomic<int> nextBuild(0);
+	int workerCount = 0;
+
+	for (int lod = 0; lod < TOTAL_MESH_LODS; lod++)
+	{
+		builds[lod].pTargetMesh = &m_CylinderMeshLODs[lod];
+		builds[TOTAL_MESH_LODS + lod].pTargetMesh = &m_SphereMeshLODs[lod];
+		builds[2 * TOTAL_MESH_LODS + lod].pTargetMesh = &m_TorusMeshLODs[lod];
+	}
+
+	// fan the generation tasks out across worker threads
+	workerCount = (int)std::thread::hardware_concurrency();
+	if (workerCount < 1)
+	{
+		workerCount = 1;
+	}
+	if (workerCount > totalBuilds)
+	{
+		workerCount = totalBuilds;
+	}
+	for (int i = 0; i < workerCount; i++)
+	{
+		workers.push_back(std::thread([&builds, &nextBuild, totalBuilds]()
+		{
+			int index = nextBuild.fetch_add(1);
+			while (index < totalBuilds)
+			{
+				int lod = index % TOTAL_MESH_LODS;
+				int divisions = g_LODDivisions[lod];
+
+				if (index < TOTAL_MESH_LODS)
+				{
+					BuildCylinderLOD(builds[index].vertices,
+						builds[index].indices, divisions);
+				}
+				else if (index < 2 * TOTAL_MESH_LODS)
+				{
+					BuildSphereLOD(builds[index].vertices,
+						builds[index].indices, divisions);
+				}
+				else
+				{
+					BuildTorusLOD(builds[index].vertices,
+						builds[index].indices, divisions, 0.2f);
+				}
+				index = nextBuild.fetch_add(1);
+			}
+		}));
+	}
+
+	// build the cheap analytic meshes on this thread while
+	// the workers generate the tessellated ones
+	LoadBoxMesh();
+	LoadPlaneMesh();
+	LoadConeMesh();
+	LoadPrismMesh();
+	LoadPyramid4Mesh();
+	LoadTaperedCylinderMesh();
+
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+
+	// append the generated meshes in task order - LoadMesh
+	// is not thread safe, the serialized appends are what
+	// keep the shared-buffer layout deterministic
+	for (int index = 0; index < totalBuilds; index++)
+	{
+		LoadMesh(*builds[index].pTargetMesh,
+			builds[index].vertices, builds[index].indices);
+	}
+}
+
+// ------------------------------------------------------------------------
+// command queue methods - one indirect command per shape per frame, using
+// the per-instance data staged with SetInstanceData()
+// ------------------------------------------------------------------------
+void ShapeMeshes::QueueBoxMesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_BoxMesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueueConeMesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_ConeMesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueueCylinderMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod)
+{
+	QueueMesh(m_CylinderMeshLODs[lod], instanceCount, baseInstance);
+}
+void ShapeMeshes::QueuePlaneMesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_PlaneMesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueuePrismMesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_PrismMesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueuePyramid4Mesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_Pyramid4Mesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueueSphereMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod)
+{
+	QueueMesh(m_SphereMeshLODs[lod], instanceCount, baseInstance);
+}
+void ShapeMeshes::QueueTaperedCylinderMesh(int instanceCount, GLuint baseInstance)
+{
+	QueueMesh(m_TaperedCylinderMesh, instanceCount, baseInstance);
+}
+void ShapeMeshes::QueueTorusMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod)
+{
+	QueueMesh(m_TorusMeshLODs[lod], instanceCount, baseInstance);
+}
@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// shapemeshes.h
+// ============
+// create meshes for various 3D primitives: plane, pyramid, cube, cone,
+// cylinder, prism, sphere, tapered cylinder, torus
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  ShapeMeshes
+ *
+ *  This class contains the code for defining the vertex
+ *  data for various basic 3D shapes, loading the data into
+ *  OpenGL buffers in memory, and drawing the shapes.
+ *
+ *  All of the loaded meshes are packed into one shared
+ *  vertex buffer and one shared index buffer under a single
+ *  vertex array.  Drawing is a queue-and-submit model: each
+ *  frame stages its per-instance data with SetInstanceData(),
+ *  queues one indirect command per draw with the Queue
+ *  methods, and SubmitIndirectFrame() replays the whole
+ *  frame with a single glMultiDrawElementsIndirect() call.
+ ***********************************************************/
+class ShapeMeshes
+{
+public:
+	// constructor
+	ShapeMeshes();
+	// destructor
+	~ShapeMeshes();
+
+	// stores the location of a mesh within the shared
+	// vertex/index buffers that hold every loaded shape
+	struct GLMesh
+	{
+		GLuint nIndices;     // number of indices of the mesh
+		GLuint indexOffset;  // byte offset of the first index
+		GLint baseVertex;    // first vertex in the shared buffer
+		bool bLoaded;        // has the mesh been loaded into memory
+	};
+
+	// tessellation levels for the curved primitives - the
+	// high level matches the original fixed tessellation,
+	// the lower levels are for distant or small objects
+	enum MESH_LOD
+	{
+		MESH_LOD_HIGH,
+		MESH_LOD_MEDIUM,
+		MESH_LOD_LOW,
+		TOTAL_MESH_LODS
+	};
+
+	// per-instance data for the instanced draw path - the
+	// layout matches the instance vertex attributes: a model
+	// matrix at locations 3-6, a material table index at
+	// location 7 and a draw state table index at location 8
+	// (padded to a 16 byte boundary).  The state index rides
+	// with the instances so the draw commands can be queued
+	// in any order each frame
+	struct INSTANCE_DATA
+	{
+		glm::mat4 modelMatrix;
+		int materialIndex;
+		int stateIndex;
+		int padding[2];
+	};
+
+	// methods for loading the shape mesh data
+	// into memory - only the shapes that are
+	// used need to be loaded
+	void LoadBoxMesh();
+	void LoadConeMesh();
+	void LoadCylinderMesh();
+	void LoadPlaneMesh();
+	void LoadPrismMesh();
+	void LoadPyramid4Mesh();
+	void LoadSphereMesh();
+	void LoadTaperedCylinderMesh();
+	void LoadTorusMesh(float thickness = 0.2f);
+
+	// load every shape mesh, generating the tessellated
+	// curved meshes on worker threads - only the appends into
+	// the shared staging buffers run on the calling thread,
+	// in a fixed order so the buffer layout is deterministic
+	void LoadAllMeshes();
+
+	// upload any newly loaded mesh data, rotate the streaming
+	// regions and bind the shared vertex array - call once per
+	// frame before staging and queueing the frame's draws
+	void BindMeshBuffers();
+
+	// stage the per-instance data into the shared instance
+	// buffer and return the base instance index the queued
+	// command for this draw must carry
+	GLuint SetInstanceData(const std::vector<INSTANCE_DATA>& instances);
+
+	// methods for queueing one indirect draw command per shape
+	// into the current frame - the commands can be queued in
+	// any order, the per-draw state travels with the staged
+	// instance data
+	void QueueBoxMesh(int instanceCount, GLuint baseInstance);
+	void QueueConeMesh(int instanceCount, GLuint baseInstance);
+	void QueueCylinderMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod = MESH_LOD_HIGH);
+	void QueuePlaneMesh(int instanceCount, GLuint baseInstance);
+	void QueuePrismMesh(int instanceCount, GLuint baseInstance);
+	void QueuePyramid4Mesh(int instanceCount, GLuint baseInstance);
+	void QueueSphereMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod = MESH_LOD_HIGH);
+	void QueueTaperedCylinderMesh(int instanceCount, GLuint baseInstance);
+	void QueueTorusMesh(int instanceCount, GLuint baseInstance, MESH_LOD lod = MESH_LOD_HIGH);
+
+	// submit every queued command for the frame with a single
+	// multi-draw-indirect call
+	void SubmitIndirectFrame();
+
+private:
+	// interleaved vertex layout for all of the shape meshes
+	struct MeshVertex
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 uv;
+	};
+
+	// one indirect draw command - the layout is fixed by the
+	// GL_DRAW_INDIRECT_BUFFER specification
+	struct DRAW_INDIRECT_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	// the loaded mesh objects - the curved shapes keep one
+	// mesh per tessellation level
+	GLMesh m_BoxMesh;
+	GLMesh m_ConeMesh;
+	GLMesh m_CylinderMeshLODs[TOTAL_MESH_LODS];
+	GLMesh m_PlaneMesh;
+	GLMesh m_PrismMesh;
+	GLMesh m_Pyramid4Mesh;
+	GLMesh m_SphereMeshLODs[TOTAL_MESH_LODS];
+	GLMesh m_TaperedCylinderMesh;
+	GLMesh m_TorusMeshLODs[TOTAL_MESH_LODS];
+
+	// the shared vertex array and the mega-buffers holding
+	// the interleaved vertex and index data for every loaded
+	// mesh - bound once per frame instead of once per draw
+	GLuint m_sharedVAO;
+	GLuint m_sharedVBO;
+	GLuint m_sharedIBO;
+	// number of rotating regions in the instance streaming
+	// buffer - three keeps the CPU a safe distance ahead of
+	// frames still in flight on the GPU
+	static const int InstanceStreamRegions = 3;
+
+	// shared buffer holding the per-instance model matrices
+	// for instanced draws - created with immutable storage,
+	// persistently mapped and read through the shared VAO at
+	// attribute locations 3-8
+	GLuint m_instanceVBO;
+	// write pointer into the persistently mapped buffer
+	INSTANCE_DATA* m_instanceStreamPtr;
+	// the region the current frame writes into
+	int m_streamRegion;
+	// instances written into the current region so far
+	GLuint m_streamCursor;
+	// per-region fences guarding against overwriting data
+	// the GPU is still reading
+	GLsync m_streamFences[InstanceStreamRegions];
+
+	// shared buffer holding the frame's indirect draw
+	// commands - streamed through the same rotating regions
+	// as the instance data and guarded by the same fences
+	GLuint m_indirectBuffer;
+	// write pointer into the persistently mapped buffer
+	DRAW_INDIRECT_COMMAND* m_indirectStreamPtr;
+	// the commands queued for the current frame so far
+	std::vector<DRAW_INDIRECT_COMMAND> m_stagedCommands;
+
+	// vertex and index data staged on the CPU by the mesh
+	// loaders, uploaded into the mega-buffers in one pass
+	std::vector<MeshVertex> m_stagedVertices;
+	std::vector<unsigned int> m_stagedIndices;
+	// has a mesh been loaded since the last upload
+	bool m_bBuffersDirty;
+
+	// append the passed in vertex and index data to the
+	// staged mega-buffer data and record where the mesh
+	// landed within it
+	void LoadMesh(
+		GLMesh& mesh,
+		const std::vector<MeshVertex>& vertices,
+		const std::vector<unsigned int>& indices);
+	// queue one indirect draw command for a loaded mesh into
+	// the current frame
+	void QueueMesh(const GLMesh& mesh, int instanceCount, GLuint baseInstance);
+
+	// generate the vertex data for one tessellation level of
+	// the curved meshes - pure CPU work with no OpenGL calls,
+	// safe to run on worker threads
+	static void BuildCylinderLOD(
+		std::vector<MeshVertex>& vertices,
+		std::vector<unsigned int>& indices,
+		int segments);
+	static void BuildSphereLOD(
+		std::vector<MeshVertex>& vertices,
+		std::vector<unsigned int>& indices,
+		int divisions);
+	static void BuildTorusLOD(
+		std::vector<MeshVertex>& vertices,
+		std::vector<unsigned int>& indices,
+		int divisions,
+		float thickness);
+
+	// append a ring of side vertices/triangles for the
+	// cylinder family of shapes (cylinder, cone, tapered)
+	static void BuildRevolvedSides(
+		std::vector<MeshVertex>& vertices,
+		std::vector<unsigned int>& indices,
+		float bottomRadius,
+		float topRadius,
+		int segments);
+	// append a horizontal cap disc at the given height
+	static void BuildCapDisc(
+		std::vector<MeshVertex>& vertices,
+		std::vector<unsigned int>& indices,
+		float radius,
+		float height,
+		bool bFacingUp,
+		int segments);
+};
@@ -0,0 +1,415 @@
+///////////////////////////////////////////////////////////////////////////////
+// benchmarkmain.cpp
+// ============
+// microbenchmark harness for the hot render-path and startup functions,
+// with machine-readable results and run-over-run comparison
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SceneManager.h"
+#include "ShapeMeshes.h"
+
+// the image decode library - the implementation is compiled
+// into SceneManager.cpp, this harness only calls into it
+#include "stb_image.h"
+
+// mode globals the linked manager sources read - owned by
+// MainCode.cpp in the application target, defined here for
+// the benchmark target which excludes that file
+bool g_DepthPrePass = false;
+bool g_OcclusionCulling = false;
+float g_RenderScale = 1.0f;
+
+// Namespace for declaring global variables
+namespace
+{
+	// the results file written after every run and compared
+	// against on the next one
+	const char* const RESULTS_FILENAME = "benchmark_results.csv";
+
+	// a result is flagged as a regression when its average
+	// slows down by more than this fraction over the last run
+	const double g_RegressionThreshold = 0.10;
+
+	// sink the benchmark work accumulates into so the
+	// optimizer cannot remove the measured code
+	volatile float g_Sink = 0.0f;
+
+	// one collected benchmark result
+	struct BENCHMARK_RESULT
+	{
+		std::string name;
+		int iterations;
+		double avgMs;
+		double minMs;
+	};
+
+	// the results collected this run
+	std::vector<BENCHMARK_RESULT> g_results;
+	// the results loaded from the previous run, by name
+	std::unordered_map<std::string, double> g_previousAvgMs;
+	// did any case regress past the threshold
+	bool g_bRegressed = false;
+	// did a whole benchmark group fail to find its assets -
+	// a silently skipped group would hide regressions forever
+	bool g_bMissingAssets = false;
+}
+
+/***********************************************************
+ *  RunCase()
+ *
+ *  This function runs the passed in benchmark work the
+ *  requested number of iterations, records the average and
+ *  minimum iteration time, and prints one machine-readable
+ *  result line with the delta against the previous run.
+ ***********************************************************/
+template <typename WORK>
+void RunCase(const char* pCaseName, int iterations, WORK work)
+{
+	BENCHMARK_RESULT result;
+	double totalMs = 0.0;
+	double minMs = -1.0;
+
+	// one untimed warmup iteration so first-touch costs do
+	// not land in the measurement
+	work();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		std::chrono::steady_clock::time_point startTime =
+			std::chrono::steady_clock::now();
+		work();
+		double elapsedMs = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - startTime).count();
+
+		totalMs += elapsedMs;
+		if ((minMs < 0.0) || (elapsedMs < minMs))
+		{
+			minMs = elapsedMs;
+		}
+	}
+
+	result.name = pCaseName;
+	result.iterations = iterations;
+	result.avgMs = totalMs / iterations;
+	result.minMs = minMs;
+	g_results.push_back(result);
+
+	std::cout << "MICROBENCH: " << result.name
+		<< " iterations:" << result.iterations
+		<< " avg:" << result.avgMs << "ms"
+		<< " min:" << result.minMs << "ms";
+
+	// compare against the previous run when one exists
+	std::unordered_map<std::string, double>::iterator previous =
+		g_previousAvgMs.find(result.name);
+	if (previous != g_previousAvgMs.end())
+	{
+		double deltaPercent =
+			(result.avgMs - previous->second) / previous->second * 100.0;
+		std::cout << " delta:" << std::showpos
+			<< std::fixed << std::setprecision(1)
+			<< deltaPercent << "%" << std::noshowpos;
+		std::cout.unsetf(std::ios::fixed);
+		std::cout << std::setprecision(6);
+		if (deltaPercent > (g_RegressionThreshold * 100.0))
+		{
+			std::cout << " REGRESSION";
+			g_bRegressed = true;
+		}
+	}
+	std::cout << std::endl;
+}
+
+/***********************************************************
+ *  LoadPreviousResults()
+ *
+ *  This function reads the results file the previous run
+ *  wrote, so each case can report its run-over-run delta.
+ ***********************************************************/
+void LoadPreviousResults()
+{
+	std::ifstream resultsFile(RESULTS_FILENAME);
+	std::string line;
+
+	if (!resultsFile.is_open())
+	{
+		return;
+	}
+
+	// skip the header line, then read name,iterations,avg,min
+	std::getline(resultsFile, line);
+	while (std::getline(resultsFile, line))
+	{
+		std::stringstream lineStream(line);
+		std::string name;
+		std::string field;
+
+		if (!std::getline(lineStream, name, ','))
+		{
+			continue;
+		}
+		// skip the iteration count field
+		if (!std::getline(lineStream, field, ','))
+		{
+			continue;
+		}
+		if (!std::getline(lineStream, field, ','))
+		{
+			continue;
+		}
+		g_previousAvgMs[name] = atof(field.c_str());
+	}
+}
+
+/***********************************************************
+ *  SaveResults()
+ *
+ *  This function writes the collected results out as the
+ *  results file the next run compares against.
+ ***********************************************************/
+void SaveResults()
+{
+	std::ofstream resultsFile(RESULTS_FILENAME, std::ios::trunc);
+
+	if (!resultsFile.is_open())
+	{
+		std::cerr << "ERROR: could not write " << RESULTS_FILENAME << std::endl;
+		return;
+	}
+
+	resultsFile << "name,iterations,avgMs,minMs" << std::endl;
+	for (size_t index = 0; index < g_results.size(); index++)
+	{
+		resultsFile << g_results[index].name << ","
+			<< g_results[index].iterations << ","
+			<< g_results[index].avgMs << ","
+			<< g_results[index].minMs << std::endl;
+	}
+}
+
+/***********************************************************
+ *  BenchmarkModelMatrixBuild()
+ *
+ *  This function measures the model matrix build the scene
+ *  preparation runs for every retained object.
+ ***********************************************************/
+void BenchmarkModelMatrixBuild()
+{
+	RunCase("model matrix build x1000", 200, []()
+	{
+		float total = 0.0f;
+		for (int i = 0; i < 1000; i++)
+		{
+			glm::mat4 modelMatrix = SceneManager::BuildModelMatrix(
+				glm::vec3(1.0f + (float)(i % 7), 2.0f, 3.0f),
+				(float)(i % 360), (float)((i * 7) % 360), (float)((i * 13) % 360),
+				glm::vec3((float)(i % 11), 0.5f, -2.0f));
+			total += modelMatrix[3][0] + modelMatrix[0][0];
+		}
+		g_Sink = g_Sink + total;
+	});
+}
+
+/***********************************************************
+ *  BenchmarkTagLookup()
+ *
+ *  This function measures how the tag-interning registry
+ *  lookups scale with the number of registered tags.  The
+ *  registry structure matches the texture and material
+ *  registries in the scene manager.
+ ***********************************************************/
+void BenchmarkTagLookup()
+{
+	const int tagCounts[] = { 16, 256, 4096 };
+
+	for (int countIndex = 0; countIndex < 3; countIndex++)
+	{
+		int tagCount = tagCounts[countIndex];
+		std::unordered_map<std::string, int> registry;
+		std::vector<std::string> tags;
+		std::stringstream caseName;
+
+		for (int i = 0; i < tagCount; i++)
+		{
+			std::stringstream tag;
+			tag << "material_tag_" << i;
+			registry[tag.str()] = i;
+			tags.push_back(tag.str());
+		}
+
+		caseName << "tag lookup x1000 (" << tagCount << " tags)";
+		RunCase(caseName.str().c_str(), 200, [&registry, &tags, tagCount]()
+		{
+			int total = 0;
+			for (int i = 0; i < 1000; i++)
+			{
+				std::unordered_map<std::string, int>::iterator found =
+					registry.find(tags[(i * 61) % tagCount]);
+				if (found != registry.end())
+				{
+					total += found->second;
+				}
+			}
+			g_Sink = g_Sink + (float)total;
+		});
+	}
+}
+
+/***********************************************************
+ *  BenchmarkMeshGeneration()
+ *
+ *  This function measures the procedural vertex generation
+ *  for each primitive, timing the same Load methods the
+ *  scene preparation calls.  Loading only stages CPU-side
+ *  vertex data - no OpenGL context is needed.
+ ***********************************************************/
+void BenchmarkMeshGeneration()
+{
+	RunCase("mesh gen box", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadBoxMesh(); });
+	RunCase("mesh gen plane", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadPlaneMesh(); });
+	RunCase("mesh gen cone", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadConeMesh(); });
+	RunCase("mesh gen prism", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadPrismMesh(); });
+	RunCase("mesh gen pyramid4", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadPyramid4Mesh(); });
+	RunCase("mesh gen tapered cylinder", 500, []()
+		{ ShapeMeshes meshes; meshes.LoadTaperedCylinderMesh(); });
+	RunCase("mesh gen cylinder (all LODs)", 200, []()
+		{ ShapeMeshes meshes; meshes.LoadCylinderMesh(); });
+	RunCase("mesh gen sphere (all LODs)", 200, []()
+		{ ShapeMeshes meshes; meshes.LoadSphereMesh(); });
+	RunCase("mesh gen torus (all LODs)", 200, []()
+		{ ShapeMeshes meshes; meshes.LoadTorusMesh(); });
+}
+
+/***********************************************************
+ *  BenchmarkTextureDecode()
+ *
+ *  This function measures the image decode for each texture
+ *  asset that is present on disk.  Decoding is the CPU side
+ *  of texture loading - the GL upload needs a context and is
+ *  covered by the application's --benchmark mode instead.
+ ***********************************************************/
+void BenchmarkTextureDecode()
+{
+	const char* textureFiles[] =
+	{
+		"textures/plastic.jpg",
+		"textures/wood.jpg",
+		"textures/brick.jpg",
+		"textures/metal2.jpg",
+	};
+	const int textureCount = sizeof(textureFiles) / sizeof(textureFiles[0]);
+
+	// the checked-in assets live under the application's Debug
+	// directory - that is the application's runtime working
+	// directory and the convention every runtime path follows.
+	// the other prefixes cover running beside the harness or
+	// beside the application project
+	const char* assetPrefixes[] =
+	{
+		"",
+		"../CS 330 Final Scene/Debug/",
+		"../CS 330 Final Scene/",
+	};
+	const int prefixCount = sizeof(assetPrefixes) / sizeof(assetPrefixes[0]);
+	int casesRun = 0;
+
+	for (int i = 0; i < textureCount; i++)
+	{
+		std::string filename;
+		std::ifstream probe;
+		for (int prefix = 0; prefix < prefixCount; prefix++)
+		{
+			filename = std::string(assetPrefixes[prefix]) + textureFiles[i];
+			probe.open(filename, std::ios::binary);
+			if (probe.is_open())
+			{
+				break;
+			}
+		}
+		if (!probe.is_open())
+		{
+			std::cout << "INFO: skipping decode benchmark, asset not found: "
+				<< textureFiles[i] << std::endl;
+			continue;
+		}
+		probe.close();
+		casesRun++;
+
+		std::stringstream caseName;
+		caseName << "texture decode " << textureFiles[i];
+		RunCase(caseName.str().c_str(), 20, [&filename]()
+		{
+			int width = 0;
+			int height = 0;
+			int colorChannels = 0;
+			unsigned char* pixels = stbi_load(filename.c_str(),
+				&width, &height, &colorChannels, 0);
+			if (NULL != pixels)
+			{
+				g_Sink = g_Sink + (float)pixels[0] + (float)width;
+				stbi_image_free(pixels);
+			}
+		});
+	}
+
+	// every asset missing means the probe paths are wrong, not
+	// that the machine lacks one file - fail the run loudly
+	// instead of letting the whole group skip forever
+	if (0 == casesRun)
+	{
+		std::cout << "ERROR: no texture decode asset was found - "
+			"check the asset probe paths" << std::endl;
+		g_bMissingAssets = true;
+	}
+}
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function runs the microbenchmark suite, prints one
+ *  machine-readable result line per case with the delta
+ *  against the previous run, and writes the results file
+ *  for the next run.  The exit code is nonzero when any
+ *  case regressed past the threshold, so the suite can gate
+ *  a build.  The headless full-frame benchmark stays in the
+ *  application target behind its --benchmark flag.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	LoadPreviousResults();
+
+	BenchmarkModelMatrixBuild();
+	BenchmarkTagLookup();
+	BenchmarkMeshGeneration();
+	BenchmarkTextureDecode();
+
+	SaveResults();
+
+	if (g_bMissingAssets)
+	{
+		std::cout << "MICROBENCH: result MISSING ASSETS" << std::endl;
+		return(EXIT_FAILURE);
+	}
+	if (g_bRegressed)
+	{
+		std::cout << "MICROBENCH: result REGRESSED" << std::endl;
+		return(EXIT_FAILURE);
+	}
+	std::cout << "MICROBENCH: result OK" << std::endl;
+	return(EXIT_SUCCESS);
+}
@@ -1,5 +1,9 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <algorithm>        // sorting the benchmark frame times
+#include <chrono>           // benchmark and startup timing
+#include <string>           // command line parsing
+#include <vector>           // benchmark frame time collection
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -13,6 +17,29 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "FrameProfiler.h"
+#include "FramePacer.h"
+#include "StartupProfiler.h"
+
+// depth pre-pass mode read by the scene manager - the frame
+// is laid down depth-only first so the lit color pass only
+// shades the fragments that end up visible.  Off by default,
+// it pays off on displays where fragment shading dominates
+bool g_DepthPrePass = false;
+
+// occlusion culling mode read by the scene manager - gates
+// each instance's draw on a hardware occlusion query of its
+// bounding-box proxy against the previous frame's depth.  Off
+// by default, it pays off on dense assembled scenes where
+// whole objects hide inside or behind others
+bool g_OcclusionCulling = false;
+
+// internal render scale read by the view manager - the scene
+// is shaded at this fraction (or multiple) of the window size
+// and upsampled for presentation, decoupling shading cost
+// from display resolution.  1.0 renders at native size;
+// adjustable at runtime with the bracket keys
+float g_RenderScale = 1.0f;
 
 // Namespace for declaring global variables
 namespace
@@ -29,12 +56,33 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// frame profiler object for the CPU/GPU frame instrumentation
+	FrameProfiler* g_FrameProfiler = nullptr;
+	// frame pacer object for the vsync mode and FPS cap
+	FramePacer* g_FramePacer = nullptr;
+
+	// benchmark mode settings - parsed from the command line,
+	// the benchmark renders a fixed number of frames into an
+	// offscreen framebuffer with a hidden window and prints
+	// frame time statistics before exiting
+	bool g_BenchmarkMode = false;
+	int g_BenchmarkFrames = 600;
+	int g_BenchmarkWidth = 1280;
+	int g_BenchmarkHeight = 720;
+
+	// frame pacing settings - parsed from the command line,
+	// vsync defaults to on so no deployment is ever left to
+	// the driver default
+	FramePacer::VSYNC_MODE g_VsyncMode = FramePacer::VSYNC_MODE_ON;
+	int g_FpsCap = 0;
 }
 
 // Function declarations - all functions that are called manually
 // need to be pre-declared at the beginning of the source code.
 bool InitializeGLFW();
 bool InitializeGLEW();
+void ParseCommandLine(int argc, char* argv[]);
+int RunBenchmark();
 
 
 /***********************************************************
@@ -45,11 +93,22 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// parse the benchmark mode settings from the command line
+	ParseCommandLine(argc, argv);
+
 	// if GLFW fails initialization, then terminate the application
+	StartupProfiler::BeginPhase("glfw init");
 	if (InitializeGLFW() == false)
 	{
 		return(EXIT_FAILURE);
 	}
+	StartupProfiler::EndPhase();
+
+	// the benchmark renders offscreen - keep the window hidden
+	if (g_BenchmarkMode)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
 
 	// try to create a new shader manager object
 	g_ShaderManager = new ShaderManager();
@@ -58,28 +117,75 @@ int main(int argc, char* argv[])
 		g_ShaderManager);
 
 	// try to create the main display window
+	StartupProfiler::BeginPhase("window create");
 	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+	StartupProfiler::EndPhase();
 
 	// if GLEW fails initialization, then terminate the application
+	StartupProfiler::BeginPhase("glew init");
 	if (InitializeGLEW() == false)
 	{
 		return(EXIT_FAILURE);
 	}
+	StartupProfiler::EndPhase();
 
 	// load the shader code from the external GLSL files
+	StartupProfiler::BeginPhase("shader load");
 	g_ShaderManager->LoadShaders(
-		"../../../Utilities/shaders/vertexShader.glsl",
-		"../../../Utilities/shaders/fragmentShader.glsl");
+		"../../Utilities/shaders/vertexShader.glsl",
+		"../../Utilities/shaders/fragmentShader.glsl");
 	g_ShaderManager->use();
+	StartupProfiler::EndPhase();
 
 	// try to create a new scene manager object and prepare the 3D scene
+	StartupProfiler::BeginPhase("scene prepare");
 	g_SceneManager = new SceneManager(g_ShaderManager);
 	g_SceneManager->PrepareScene();
+	StartupProfiler::EndPhase();
+
+	// print the boot waterfall - boot-to-first-frame is the
+	// startup metric, and this shows where it went
+	StartupProfiler::ReportWaterfall();
+
+	// start the camera update thread - input processing and
+	// camera math run there, the loops below only consume the
+	// frame-state snapshots it publishes
+	g_ViewManager->StartUpdateThread();
 
-	// loop will keep running until the application is closed 
+	// in benchmark mode, render the fixed frame run offscreen,
+	// print the frame time statistics and exit
+	if (g_BenchmarkMode)
+	{
+		int benchmarkResult = RunBenchmark();
+		g_ViewManager->StopUpdateThread();
+		delete g_SceneManager;
+		delete g_ViewManager;
+		delete g_ShaderManager;
+		glfwTerminate();
+		exit(benchmarkResult);
+	}
+
+	// try to create a new frame profiler object for the
+	// CPU/GPU frame-time instrumentation
+	g_FrameProfiler = new FrameProfiler();
+	g_FrameProfiler->Initialize();
+
+	// apply the configured vsync mode and FPS cap - the
+	// benchmark path above runs unpaced on purpose
+	g_FramePacer = new FramePacer();
+	g_FramePacer->Initialize(g_VsyncMode, g_FpsCap);
+
+	// loop will keep running until the application is closed
 	// or until an error has occurred
 	while (!glfwWindowShouldClose(g_Window))
 	{
+		g_FrameProfiler->BeginFrame();
+
+		// bind the scene render target - an offscreen buffer at
+		// the configured render scale, or the window framebuffer
+		// directly when the scale is 1.0
+		g_ViewManager->BeginSceneRender();
+
 		// Enable z-depth
 		glEnable(GL_DEPTH_TEST);
 
@@ -88,20 +194,48 @@ int main(int argc, char* argv[])
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// convert from 3D object space to 2D view
+		g_FrameProfiler->BeginGPUScope(FrameProfiler::GPU_SCOPE_VIEW);
 		g_ViewManager->PrepareSceneView();
+		g_FrameProfiler->EndGPUScope(FrameProfiler::GPU_SCOPE_VIEW);
 
 		// refresh the 3D scene
+		g_FrameProfiler->BeginGPUScope(FrameProfiler::GPU_SCOPE_SCENE);
 		g_SceneManager->RenderScene();
+		g_FrameProfiler->EndGPUScope(FrameProfiler::GPU_SCOPE_SCENE);
 
+		// upsample the scaled scene target to the window
+		g_ViewManager->PresentSceneRender();
 
 		// Flips the the back buffer with the front buffer every frame.
 		glfwSwapBuffers(g_Window);
 
-		// query the latest GLFW events
+		// collect the timings and counters for the frame
+		g_FrameProfiler->EndFrame();
+
+		// detect missed vsyncs and hold the frame to the FPS
+		// cap - after the profiler so the pacing wait is not
+		// booked as frame cost
+		g_FramePacer->Pace();
+
+		// query the latest GLFW events - the input callbacks
+		// run here and hand their deltas to the update thread
 		glfwPollEvents();
 	}
 
+	// bring the camera update thread down before the managers
+	g_ViewManager->StopUpdateThread();
+
 	// clear the allocated manager objects from memory
+	if (NULL != g_FramePacer)
+	{
+		delete g_FramePacer;
+		g_FramePacer = NULL;
+	}
+	if (NULL != g_FrameProfiler)
+	{
+		delete g_FrameProfiler;
+		g_FrameProfiler = NULL;
+	}
 	if (NULL != g_SceneManager)
 	{
 		delete g_SceneManager;
@@ -122,10 +256,220 @@ int main(int argc, char* argv[])
 	exit(EXIT_SUCCESS); 
 }
 
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to parse the benchmark settings
+ *  from the command line arguments:
+ *    --benchmark          enable the headless benchmark mode
+ *    --frames <count>     number of frames to render
+ *    --width <pixels>     offscreen framebuffer width
+ *    --height <pixels>    offscreen framebuffer height
+ *    --prepass            enable the depth pre-pass
+ *    --occlusion          enable the occlusion culling
+ *    --vsync <mode>       vsync mode: on, off or adaptive
+ *    --fps <cap>          cap the frame rate, 0 = uncapped
+ *    --render-scale <s>   internal render scale, 0.25 - 2.0
+ ***********************************************************/
+void ParseCommandLine(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--benchmark")
+		{
+			g_BenchmarkMode = true;
+		}
+		else if ((argument == "--frames") && (i + 1 < argc))
+		{
+			g_BenchmarkFrames = atoi(argv[++i]);
+		}
+		else if ((argument == "--width") && (i + 1 < argc))
+		{
+			g_BenchmarkWidth = atoi(argv[++i]);
+		}
+		else if ((argument == "--height") && (i + 1 < argc))
+		{
+			g_BenchmarkHeight = atoi(argv[++i]);
+		}
+		else if (argument == "--prepass")
+		{
+			g_DepthPrePass = true;
+		}
+		else if (argument == "--occlusion")
+		{
+			g_OcclusionCulling = true;
+		}
+		else if ((argument == "--vsync") && (i + 1 < argc))
+		{
+			std::string mode = argv[++i];
+			if (mode == "off")
+			{
+				g_VsyncMode = FramePacer::VSYNC_MODE_OFF;
+			}
+			else if (mode == "adaptive")
+			{
+				g_VsyncMode = FramePacer::VSYNC_MODE_ADAPTIVE;
+			}
+			else
+			{
+				g_VsyncMode = FramePacer::VSYNC_MODE_ON;
+			}
+		}
+		else if ((argument == "--fps") && (i + 1 < argc))
+		{
+			g_FpsCap = atoi(argv[++i]);
+			if (g_FpsCap < 0)
+			{
+				g_FpsCap = 0;
+			}
+		}
+		else if ((argument == "--render-scale") && (i + 1 < argc))
+		{
+			g_RenderScale = (float)atof(argv[++i]);
+			if (g_RenderScale < 0.25f)
+			{
+				g_RenderScale = 0.25f;
+			}
+			if (g_RenderScale > 2.0f)
+			{
+				g_RenderScale = 2.0f;
+			}
+		}
+	}
+
+	if (g_BenchmarkFrames < 1)
+	{
+		g_BenchmarkFrames = 1;
+	}
+}
+
+/***********************************************************
+ *	RunBenchmark()
+ *
+ *  This function renders the fixed benchmark frame run
+ *  into an offscreen framebuffer and prints the min/avg/p99
+ *  frame times.  Each frame ends with glFinish() so the
+ *  measured time covers the full CPU and GPU cost, making
+ *  the numbers comparable run-over-run.
+ ***********************************************************/
+int RunBenchmark()
+{
+	GLuint fboID = 0;
+	GLuint colorBufferID = 0;
+	GLuint depthBufferID = 0;
+	int renderWidth = 0;
+	int renderHeight = 0;
+	std::vector<double> frameTimes;
+
+	// the render scale gives the benchmark a resolution axis
+	// on top of the output size - the framebuffer is allocated
+	// at the scaled size just like the interactive scene target
+	renderWidth = (int)((float)g_BenchmarkWidth * g_RenderScale);
+	renderHeight = (int)((float)g_BenchmarkHeight * g_RenderScale);
+	if (renderWidth < 1)
+	{
+		renderWidth = 1;
+	}
+	if (renderHeight < 1)
+	{
+		renderHeight = 1;
+	}
+
+	// create the offscreen framebuffer at the benchmark
+	// resolution with color and depth renderbuffers
+	glGenFramebuffers(1, &fboID);
+	glBindFramebuffer(GL_FRAMEBUFFER, fboID);
+
+	glGenRenderbuffers(1, &colorBufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8,
+		renderWidth, renderHeight);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_RENDERBUFFER, colorBufferID);
+
+	glGenRenderbuffers(1, &depthBufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+		renderWidth, renderHeight);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+		GL_RENDERBUFFER, depthBufferID);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cerr << "ERROR: Benchmark framebuffer is not complete" << std::endl;
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glDeleteRenderbuffers(1, &colorBufferID);
+		glDeleteRenderbuffers(1, &depthBufferID);
+		glDeleteFramebuffers(1, &fboID);
+		return(EXIT_FAILURE);
+	}
+
+	glViewport(0, 0, renderWidth, renderHeight);
+	frameTimes.reserve(g_BenchmarkFrames);
+
+	// render the fixed frame run
+	for (int frame = 0; frame < g_BenchmarkFrames; frame++)
+	{
+		std::chrono::steady_clock::time_point frameStartTime =
+			std::chrono::steady_clock::now();
+
+		// Enable z-depth
+		glEnable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// refresh the 3D scene
+		g_SceneManager->RenderScene();
+
+		// wait for the GPU so the frame time covers the
+		// complete frame cost
+		glFinish();
+
+		frameTimes.push_back(std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - frameStartTime).count());
+
+		// keep the hidden window responsive to the system
+		glfwPollEvents();
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteRenderbuffers(1, &colorBufferID);
+	glDeleteRenderbuffers(1, &depthBufferID);
+	glDeleteFramebuffers(1, &fboID);
+
+	// compute and print the frame time statistics
+	std::vector<double> sortedTimes = frameTimes;
+	std::sort(sortedTimes.begin(), sortedTimes.end());
+
+	double totalMs = 0.0;
+	for (size_t i = 0; i < sortedTimes.size(); i++)
+	{
+		totalMs += sortedTimes[i];
+	}
+	size_t p99Index = (size_t)(0.99 * (sortedTimes.size() - 1));
+
+	std::cout << "BENCHMARK: resolution:" << g_BenchmarkWidth << "x" << g_BenchmarkHeight
+		<< " scale:" << g_RenderScale
+		<< " frames:" << g_BenchmarkFrames
+		<< " min:" << sortedTimes.front() << "ms"
+		<< " avg:" << (totalMs / sortedTimes.size()) << "ms"
+		<< " p99:" << sortedTimes[p99Index] << "ms"
+		<< std::endl;
+
+	return(EXIT_SUCCESS);
+}
+
 /***********************************************************
  *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
+ *
+ *  This function is used to initialize the GLFW library.
  ***********************************************************/
 bool InitializeGLFW()
 {
@@ -1,1533 +1,2412 @@
-///////////////////////////////////////////////////////////////////////////////
-// shadermanager.cpp
-// ============
-// manage the loading and rendering of 3D scenes
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#include <glm/gtx/transform.hpp>
-
-// declare the global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager* pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-
-	// initialize the texture collection
-	for (int i = 0; i < 16; i++)
-	{
-		m_textureIDs[i].tag = "/0";
-		m_textureIDs[i].ID = -1;
-	}
-	m_loadedTextures = 0;
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	// clear the allocated memory
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-	// destroy the created OpenGL textures
-	DestroyGLTextures();
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.ambientColor = m_objectMaterials[index].ambientColor;
-			material.ambientStrength = m_objectMaterials[index].ambientStrength;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
-}
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
- /***********************************************************
-  *  LoadSceneTextures()
-  *
-  *  This method is used for preparing the 3D scene by loading
-  *  the shapes, textures in memory to support the 3D scene
-  *  rendering
-  ***********************************************************/
-void SceneManager::LoadSceneTextures()
-{
-	/*** STUDENTS - add the code BELOW for loading the textures that ***/
-	/*** will be used for mapping to objects in the 3D scene. Up to  ***/
-	/*** 16 textures can be loaded per scene. Refer to the code in   ***/
-	/*** the OpenGL Sample for help.                                 ***/
-	//load the various textures for the pyramid structure and different object meshes
-	bool bReturn = false;
-
-	bReturn = CreateGLTexture(
-		"textures/plastic.jpg",
-		"plastic");
-
-	bReturn = CreateGLTexture(
-		"textures/wood.jpg",
-		"wood");
-
-	bReturn = CreateGLTexture(
-		"textures/red.jpg",
-		"red");
-
-	bReturn = CreateGLTexture(
-		"textures/grip.jpg",
-		"grip");
-
-	bReturn = CreateGLTexture(
-		"textures/brick.jpg",
-		"brick");
-
-	bReturn = CreateGLTexture(
-		"textures/blue.jpg",
-		"blue");
-
-	bReturn = CreateGLTexture(
-		"textures/silver.jpg",
-		"silver");
-
-	bReturn = CreateGLTexture(
-		"textures/yellow.jpg",
-		"yellow");
-
-	bReturn = CreateGLTexture(
-		"textures/metal2.jpg",
-		"metal2");
-
-
-	// after the texture image data is loaded into memory, the
-	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
-	BindGLTextures();
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		// find the defined material that matches the tag
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			// pass the material properties into the shader
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/***********************************************************
- *  DefineObjectMaterials()
- *
- *  This method is used for configuring the various material
- *  settings for all of the objects within the 3D scene.
- ***********************************************************/
-void SceneManager::DefineObjectMaterials()
-{
-	/*** STUDENTS - add the code BELOW for defining object materials. ***/
-	/*** There is no limit to the number of object materials that can ***/
-	/*** be defined. Refer to the code in the OpenGL Sample for help  ***/
-	OBJECT_MATERIAL goldMaterial; //first more reflective materal
-	goldMaterial.ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
-	goldMaterial.ambientStrength = 5.0f;
-	goldMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
-	goldMaterial.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
-	goldMaterial.shininess = 12.0;
-	goldMaterial.tag = "metal";
-
-	m_objectMaterials.push_back(goldMaterial);
-
-	OBJECT_MATERIAL woodMaterial; //second less reflective materal
-	woodMaterial.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	woodMaterial.ambientStrength = 2.0f;
-	woodMaterial.diffuseColor = glm::vec3(0.3f, 0.3f, 0.3f);
-	woodMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	woodMaterial.shininess = 4.0;
-	woodMaterial.tag = "wood";
-
-	OBJECT_MATERIAL plasticMaterial; //second less reflective materal
-	woodMaterial.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	woodMaterial.ambientStrength = 1.5f;
-	woodMaterial.diffuseColor = glm::vec3(0.3f, 0.3f, 0.3f);
-	woodMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	woodMaterial.shininess = 1.0;
-	woodMaterial.tag = "plastic";
-
-
-}
-
-/***********************************************************
- *  SetupSceneLights()
- *
- *  This method is called to add and configure the light
- *  sources for the 3D scene.  There are up to 4 light sources.
- ***********************************************************/
-void SceneManager::SetupSceneLights()
-{
-	// Enable custom lighting in shaders
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	m_pShaderManager->setVec3Value("lightSources[0].position", 0.0f, 10.0f, 20.0f);
-	m_pShaderManager->setVec3Value("lightSources[0].ambientColor", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setVec3Value("lightSources[0].diffuseColor", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("lightSources[0].specularColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].focalStrength", 42.0f);
-	m_pShaderManager->setFloatValue("lightSources[0].specularIntensity", 0.05f);
-
-	m_pShaderManager->setVec3Value("lightSources[1].position", -15.0f, 10.0f, -15.0f);
-	m_pShaderManager->setVec3Value("lightSources[1].ambientColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setVec3Value("lightSources[1].diffuseColor", 0.4f, 0.4f, 0.4f);
-	m_pShaderManager->setVec3Value("lightSources[1].specularColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[1].focalStrength", 38.0f);
-	m_pShaderManager->setFloatValue("lightSources[1].specularIntensity", 0.05f);
-
-	m_pShaderManager->setVec3Value("lightSources[2].position", 20.0f, 10.0f, 1.0f);
-	m_pShaderManager->setVec3Value("lightSources[2].ambientColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setVec3Value("lightSources[2].diffuseColor", 0.3f, 0.3f, 0.3f);
-	m_pShaderManager->setVec3Value("lightSources[2].specularColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[2].focalStrength", 74.0f);
-	m_pShaderManager->setFloatValue("lightSources[2].specularIntensity", 0.05f);
-
-	m_pShaderManager->setVec3Value("lightSources[3].position", 0.0f, 0.0f, -25.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].ambientColor", 0.2f, 0.2f, 0.2f);
-	m_pShaderManager->setVec3Value("lightSources[3].diffuseColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setVec3Value("lightSources[3].specularColor", 1.0f, 1.0f, 1.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].focalStrength", 26.0f);
-	m_pShaderManager->setFloatValue("lightSources[3].specularIntensity", 0.05f);
-}
-
-
-/***********************************************************
- *  PrepareScene()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene
- *  rendering
- ***********************************************************/
-void SceneManager::PrepareScene()
-{
-	// load the textures for the 3D scene
-	LoadSceneTextures();
-
-	// add and defile the light sources for the 3D scene
-	SetupSceneLights();
-
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadConeMesh();
-	m_basicMeshes->LoadPrismMesh();
-	m_basicMeshes->LoadPyramid4Mesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadTaperedCylinderMesh();
-	m_basicMeshes->LoadTorusMesh();
-}
-
-/***********************************************************
- *  RenderScene()
- *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
- ***********************************************************/
-void SceneManager::RenderScene()
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(25.0f, 5.0f, 20.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-7.0f, 0.0f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(1, 0.540, 0.540, 0.540);
-	//Set the texture of the table to wood
-	SetShaderTexture("wood");
-	SetTextureUVScale(1.0, 1.0);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawPlaneMesh();
-	/****************************************************************/
-
-	//First Clinder Flashlight Base
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 4.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.184, 0.310, 0.310, 1);
-	//set the flashlight piece to the plastic texture
-	SetShaderTexture("plastic");
-	SetTextureUVScale(1.0, 1.0);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Clyinder for flashlight grip
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 2.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 4.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.502, 0.502, 0.502, 1);
-	SetShaderTexture("grip");
-	SetTextureUVScale(0.5, 0.5);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Second cylinder for base of flashlight after grip
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 6.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.184, 0.310, 0.310, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(1.0, 1.0);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Third base cylinder tapering off slightly
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.8f, 3.0f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 7.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.184, 0.310, 0.310, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(1.0, 1.0);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Fourth cylinder for base back to original width near battery compartment
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 1.7f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 10.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	SetShaderColor(0.184, 0.310, 0.310, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(1.0, 1.0);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//Fifth cylinder for the flashlight button
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.7f, 0.3f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 11.6f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1.000, 0.000, 0.000, 1);
-	SetShaderTexture("red");
-	SetTextureUVScale(2.0, 2.0);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//First box representing the flashlight belt clip
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.8f, 0.1f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(1.3f, 11.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	//Second box representing the flashlight belt clip
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.3f, 4.0f, 0.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(1.5f, 9.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// OBJECT 2: Card Box
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(12.0f, 14.0f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-12.0f, 7.2f, -12.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("blue");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	//Card Box logo using cones
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.5f, 2.9f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-12.0f, 9.8f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	//Card Box logo using cones 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.5f, 2.9f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 60.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-14.0f, 9.0f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	//Card Box logo using cones 3
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.5f, 2.9f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -60.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-10.6f, 9.0f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	//Card Box logo using cones 4
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.5f, 2.9f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -150.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-11.2f, 7.4f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	//Card Box logo using cones 5
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.5f, 2.9f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 150.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-13.3f, 7.4f, -7.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawConeMesh();
-
-	//Card Box logo using cylinder
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(2.5f, 0.3f, 2.5f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-12.3f, 8.4f, -7.2f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	// OBJECT 3: Wallet
-	// 
-	// Bottom of metallic wallet
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.4f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 0.6f, -13.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("metal2");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Middle of wallet holding plastic cards
-	// Card 1
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.2f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 0.9f, -13.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("red");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Card 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.2f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 1.1f, -13.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("blue");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Card 3
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.2f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 1.3f, -13.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("yellow");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Top of metallic wallet
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(8.0f, 0.4f, 10.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 1.6f, -13.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("metal2");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Elastic holding wallet together 1
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.4f, 4.4f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 1.15f, -7.8f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Elastic holding wallet together 2
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.4f, 4.4f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(6.0f, 1.15f, -18.1f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Elastic holding wallet together 3
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.4f, 3.0f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(2.0f, 1.15f, -13.1f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Elastic holding wallet together 4
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.4f, 3.0f, 0.1f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(10.0f, 1.15f, -13.1f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("wood");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Wallet logo
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.0f, 0.1f, 1.0f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(8.4f, 1.8f, -9.5f);;
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	//OBJECT 4: Metallic silver watch
-	// Watch face
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.7f, 0.3f, 1.7f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-13.0f, 0.5f, 2.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(1.0, 1.0, 1.0, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	// Watch face border
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.8f, 0.3f, 1.8f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-13.0f, 0.4f, 2.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("metal2");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawCylinderMesh();
-
-	// Watch button
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.2f, 0.1f, 0.2f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 90.0f;
-	ZrotationDegrees = 90.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-12.85f, 0.54f, 3.8f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawSphereMesh();
-
-	// Watch link left
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.2f, 0.3f, 2.2f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-15.0f, 0.52f, 2.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Watch link right
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(1.2f, 0.3f, 2.2f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-11.0f, 0.52f, 2.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Watch link right
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(10.5f, 0.3f, 1.8f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-13.0f, 0.2f, 2.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("silver");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("metal");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Watch face minute hand
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.1f, 0.1f, 1.2f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 30.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-13.2f, 0.9f, 1.8f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-
-	// Watch face hour hand
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.1f, 0.1f, 0.7f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(-12.9f, 0.9f, 1.9f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	//SetShaderColor(0.663, 0.663, 0.663, 1);
-	SetShaderTexture("plastic");
-	SetTextureUVScale(0.1, 0.1);
-	SetShaderMaterial("plastic");
-
-	// draw the mesh with transformation values
-	m_basicMeshes->DrawBoxMesh();
-}
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+// shadermanager.cpp
+// ============
+// manage the loading and rendering of 3D scenes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+
+#include "FrameProfiler.h"
+#include "StartupProfiler.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+// declare the global variables
+namespace
+{
+	// uniform buffer binding points for the light and
+	// material blocks in the fragment shader - these match
+	// the explicit binding layout in the shader sources
+	const GLuint g_LightBlockBinding = 0;
+	const GLuint g_MaterialBlockBinding = 1;
+	// storage buffer binding point for the per-draw state
+	// table in the fragment shader
+	const GLuint g_DrawStateBlockBinding = 2;
+	// uniform buffer binding points for the per-frame camera
+	// block and the shadow matrix block
+	const GLuint g_CameraBlockBinding = 3;
+	const GLuint g_ShadowBlockBinding = 4;
+	// the size of the material table in the fragment shader
+	const int g_MaxMaterials = 16;
+	// the size of the light source array in the fragment shader
+	const int g_MaxLights = 4;
+
+	// resolution of each cached shadow map layer
+	const GLsizei g_ShadowMapSize = 1024;
+	// the texture unit the shadow map array binds to - the
+	// scene textures occupy units 0 through 15
+	const GLuint g_ShadowMapTextureUnit = 16;
+
+	// std140 mirror of the LightSource struct in the fragment
+	// shader - vec3 members are aligned to 16 byte boundaries
+	struct LIGHT_DATA
+	{
+		glm::vec3 position;
+		float padding0;
+		glm::vec3 ambientColor;
+		float padding1;
+		glm::vec3 diffuseColor;
+		float padding2;
+		glm::vec3 specularColor;
+		float focalStrength;
+		float specularIntensity;
+		float padding3[3];
+	};
+
+	// std140 mirror of the Material struct in the fragment
+	// shader
+	struct MATERIAL_DATA
+	{
+		float ambientStrength;
+		float padding0[3];
+		glm::vec3 ambientColor;
+		float padding1;
+		glm::vec3 diffuseColor;
+		float padding2;
+		glm::vec3 specularColor;
+		float shininess;
+	};
+
+	// std140 mirror of the CameraBlock in the shaders - used
+	// to stand a light's view in for the camera while its
+	// shadow map renders through the depth-only variant
+	struct SHADOW_CAMERA_DATA
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 viewPosition;
+	};
+
+	// std430 mirror of the DrawState struct in the fragment
+	// shader - one record per draw batch, indexed with the
+	// draw ID of the multi-draw-indirect frame
+	struct DRAW_STATE_DATA
+	{
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		glm::vec2 uvOffset;
+		int bUseTexture;
+		int textureSlot;
+		int padding[2];
+	};
+
+	// layout of the header in a DDS texture container - the
+	// file starts with the FourCC "DDS " followed by these
+	// structures, then the compressed mip chain
+	struct DDS_PIXELFORMAT
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t fourCC;
+		uint32_t RGBBitCount;
+		uint32_t RBitMask;
+		uint32_t GBitMask;
+		uint32_t BBitMask;
+		uint32_t ABitMask;
+	};
+
+	struct DDS_HEADER
+	{
+		uint32_t size;
+		uint32_t flags;
+		uint32_t height;
+		uint32_t width;
+		uint32_t pitchOrLinearSize;
+		uint32_t depth;
+		uint32_t mipMapCount;
+		uint32_t reserved1[11];
+		DDS_PIXELFORMAT ddspf;
+		uint32_t caps;
+		uint32_t caps2;
+		uint32_t caps3;
+		uint32_t caps4;
+		uint32_t reserved2;
+	};
+
+	// extended header present when the pixel format FourCC
+	// is "DX10" - carries the DXGI format for BC7 textures
+	struct DDS_HEADER_DXT10
+	{
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	const uint32_t g_DDSMagic = 0x20534444;    // "DDS "
+	const uint32_t g_FourCC_DXT1 = 0x31545844; // "DXT1" - BC1
+	const uint32_t g_FourCC_DXT5 = 0x35545844; // "DXT5" - BC3
+	const uint32_t g_FourCC_DX10 = 0x30315844; // "DX10" - extended header
+	const uint32_t g_DXGIFormatBC7Unorm = 98;  // DXGI_FORMAT_BC7_UNORM
+
+	// check whether a texture filename is a DDS container
+	bool IsDDSFile(const std::string& filename)
+	{
+		return((filename.size() > 4) &&
+			(filename.compare(filename.size() - 4, 4, ".dds") == 0));
+	}
+
+	// the binary scene file - fixed-size retained draw records
+	// read straight into the scene object array in one pass.
+	// the records store the resolved texture slots and material
+	// indices, which depend on the texture/material definition
+	// order, so the format version must be bumped whenever that
+	// order or the record layout changes
+	const char* g_SceneFile = "scene.bin";
+	const uint32_t g_SceneFileMagic = 0x424E4353;  // "SCNB"
+	const uint32_t g_SceneFileVersion = 3;
+
+	// largest texture dimension that gets packed into the
+	// shared texture atlas - anything larger keeps its own
+	// texture object so it can tile across surfaces
+	const int g_AtlasMaxTileSize = 256;
+
+	// layout of the header at the front of the scene file
+	struct SCENE_FILE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t recordSize;
+		uint32_t objectCount;
+	};
+
+	// camera distances at which the curved meshes drop to the
+	// medium and low tessellation levels
+	const float g_LODMediumDistance = 25.0f;
+	const float g_LODLowDistance = 60.0f;
+
+	// select the tessellation level for a curved mesh from
+	// its distance to the camera
+	ShapeMeshes::MESH_LOD SelectMeshLOD(float cameraDistance)
+	{
+		if (cameraDistance < g_LODMediumDistance)
+		{
+			return(ShapeMeshes::MESH_LOD_HIGH);
+		}
+		if (cameraDistance < g_LODLowDistance)
+		{
+			return(ShapeMeshes::MESH_LOD_MEDIUM);
+		}
+		return(ShapeMeshes::MESH_LOD_LOW);
+	}
+
+	// does the mesh have multiple tessellation levels
+	bool IsLODMesh(SceneManager::MESH_ID meshID)
+	{
+		return((meshID == SceneManager::MESH_CYLINDER) ||
+			(meshID == SceneManager::MESH_SPHERE) ||
+			(meshID == SceneManager::MESH_TORUS));
+	}
+
+	// local-space bounding spheres for the basic meshes,
+	// indexed by MESH_ID - xyz is the center, w the radius
+	// of the unit-sized shape as generated by ShapeMeshes
+	const glm::vec4 g_MeshBounds[] =
+	{
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.415f),  // MESH_PLANE
+		glm::vec4(0.0f, 0.0f, 0.0f, 0.867f),  // MESH_BOX
+		glm::vec4(0.0f, 0.5f, 0.0f, 1.119f),  // MESH_CYLINDER
+		glm::vec4(0.0f, 0.5f, 0.0f, 1.119f),  // MESH_CONE
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),    // MESH_SPHERE
+		glm::vec4(0.0f, 0.0f, 0.0f, 0.867f),  // MESH_PRISM
+		glm::vec4(0.0f, 0.0f, 0.0f, 0.867f),  // MESH_PYRAMID4
+		glm::vec4(0.0f, 0.5f, 0.0f, 1.119f),  // MESH_TAPERED_CYLINDER
+		glm::vec4(0.0f, 0.0f, 0.0f, 1.2f)     // MESH_TORUS
+	};
+}
+
+// the camera position published each frame by the view manager
+extern glm::vec3 g_ViewPosition;
+// the view-frustum planes published each frame by the view manager
+extern glm::vec4 g_FrustumPlanes[6];
+// depth pre-pass mode parsed from the command line - lays the
+// frame's depth down first so the lit color pass only shades
+// the fragments that actually end up visible
+extern bool g_DepthPrePass;
+// occlusion culling mode parsed from the command line - gates
+// each instance's draw on a hardware occlusion query of its
+// bounding-box proxy against the previous frame's depth
+extern bool g_OcclusionCulling;
+
+namespace
+{
+	// test a world-space bounding sphere against the current
+	// view frustum - the sphere is outside when it sits fully
+	// behind any of the six planes
+	bool SphereInFrustum(const glm::vec4& bounds)
+	{
+		for (int plane = 0; plane < 6; plane++)
+		{
+			float distance = glm::dot(glm::vec3(g_FrustumPlanes[plane]),
+				glm::vec3(bounds)) + g_FrustumPlanes[plane].w;
+			if (distance < -bounds.w)
+			{
+				return(false);
+			}
+		}
+		return(true);
+	}
+
+	// when the camera sits this close to an instance's
+	// bounding sphere the near plane can clip its proxy box
+	// away entirely - those instances are just kept visible
+	const float g_OcclusionNearMargin = 0.5f;
+
+	// the unit box drawn as the occlusion proxy - positions
+	// only, matching the extent of the box mesh so a scale of
+	// twice the bounding sphere radius encloses the sphere
+	const float g_OcclusionBoxVertices[] =
+	{
+		// back face
+		-0.5f, -0.5f, -0.5f,  0.5f,  0.5f, -0.5f,  0.5f, -0.5f, -0.5f,
+		 0.5f,  0.5f, -0.5f, -0.5f, -0.5f, -0.5f, -0.5f,  0.5f, -0.5f,
+		// front face
+		-0.5f, -0.5f,  0.5f,  0.5f, -0.5f,  0.5f,  0.5f,  0.5f,  0.5f,
+		 0.5f,  0.5f,  0.5f, -0.5f,  0.5f,  0.5f, -0.5f, -0.5f,  0.5f,
+		// left face
+		-0.5f,  0.5f,  0.5f, -0.5f,  0.5f, -0.5f, -0.5f, -0.5f, -0.5f,
+		-0.5f, -0.5f, -0.5f, -0.5f, -0.5f,  0.5f, -0.5f,  0.5f,  0.5f,
+		// right face
+		 0.5f,  0.5f,  0.5f,  0.5f, -0.5f, -0.5f,  0.5f,  0.5f, -0.5f,
+		 0.5f, -0.5f, -0.5f,  0.5f,  0.5f,  0.5f,  0.5f, -0.5f,  0.5f,
+		// bottom face
+		-0.5f, -0.5f, -0.5f,  0.5f, -0.5f, -0.5f,  0.5f, -0.5f,  0.5f,
+		 0.5f, -0.5f,  0.5f, -0.5f, -0.5f,  0.5f, -0.5f, -0.5f, -0.5f,
+		// top face
+		-0.5f,  0.5f, -0.5f,  0.5f,  0.5f,  0.5f,  0.5f,  0.5f, -0.5f,
+		 0.5f,  0.5f,  0.5f, -0.5f,  0.5f, -0.5f, -0.5f,  0.5f,  0.5f
+	};
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager* pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_basicMeshes = new ShapeMeshes();
+
+	// the uniform and storage buffers are created when the
+	// light, material and draw state data is uploaded during
+	// scene preparation
+	m_lightsUBO = 0;
+	m_materialsUBO = 0;
+	m_drawStateSSBO = 0;
+
+	// the occlusion proxy mesh is created during scene
+	// preparation when the occlusion culling mode is on
+	m_occlusionVAO = 0;
+	m_occlusionVBO = 0;
+
+	// the shadow map resources are created on the first frame
+	// that finds an invalidated map
+	m_shadowFBO = 0;
+	m_shadowMapArray = 0;
+	m_shadowMatricesUBO = 0;
+	m_shadowCameraUBO = 0;
+	m_lightCount = 0;
+	m_sceneBounds = glm::vec4(0.0f);
+	for (int light = 0; light < g_MaxLights; light++)
+	{
+		m_shadowMatrices[light] = glm::mat4(1.0f);
+		m_lightPositions[light] = glm::vec3(0.0f);
+		m_shadowMapDirty[light] = false;
+	}
+
+	// initialize the texture collection
+	for (int i = 0; i < 16; i++)
+	{
+		m_textureIDs[i].tag = "/0";
+		m_textureIDs[i].ID = -1;
+	}
+	m_loadedTextures = 0;
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	// clear the allocated memory
+	m_pShaderManager = NULL;
+	delete m_basicMeshes;
+	m_basicMeshes = NULL;
+	// destroy the created OpenGL textures
+	DestroyGLTextures();
+	// free the light and material uniform buffers
+	if (0 != m_lightsUBO)
+	{
+		glDeleteBuffers(1, &m_lightsUBO);
+		m_lightsUBO = 0;
+	}
+	if (0 != m_materialsUBO)
+	{
+		glDeleteBuffers(1, &m_materialsUBO);
+		m_materialsUBO = 0;
+	}
+	// free the per-draw state storage buffer
+	if (0 != m_drawStateSSBO)
+	{
+		glDeleteBuffers(1, &m_drawStateSSBO);
+		m_drawStateSSBO = 0;
+	}
+	// free the cached shadow map resources
+	if (0 != m_shadowFBO)
+	{
+		glDeleteFramebuffers(1, &m_shadowFBO);
+		glDeleteTextures(1, &m_shadowMapArray);
+		glDeleteBuffers(1, &m_shadowMatricesUBO);
+		glDeleteBuffers(1, &m_shadowCameraUBO);
+		m_shadowFBO = 0;
+		m_shadowMapArray = 0;
+		m_shadowMatricesUBO = 0;
+		m_shadowCameraUBO = 0;
+	}
+	// free the occlusion proxy mesh and the query objects
+	if (0 != m_occlusionVAO)
+	{
+		glDeleteBuffers(1, &m_occlusionVBO);
+		glDeleteVertexArrays(1, &m_occlusionVAO);
+		m_occlusionVBO = 0;
+		m_occlusionVAO = 0;
+	}
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		DRAW_BATCH& batch = m_drawBatches[index];
+		for (size_t instance = 0; instance < batch.occlusion.size(); instance++)
+		{
+			glDeleteQueries(1, &batch.occlusion[instance].queryID);
+		}
+	}
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material)
+{
+	int index = -1;
+
+	// resolve the tag to a material index through the registry
+	index = FindMaterialIndex(tag);
+	if (index < 0)
+	{
+		return(false);
+	}
+
+	material.ambientColor = m_objectMaterials[index].ambientColor;
+	material.ambientStrength = m_objectMaterials[index].ambientStrength;
+	material.diffuseColor = m_objectMaterials[index].diffuseColor;
+	material.specularColor = m_objectMaterials[index].specularColor;
+	material.shininess = m_objectMaterials[index].shininess;
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the index of a material
+ *  in the defined materials list that is associated with
+ *  the passed in tag.  The tags are interned into a hash
+ *  registry when the materials are defined, so the lookup
+ *  is a single hash probe instead of a linear string scan.
+ *  Returns -1 when the tag is unknown.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag)
+{
+	std::unordered_map<std::string, MaterialHandle>::const_iterator
+		iter = m_materialRegistry.find(tag);
+	if (iter != m_materialRegistry.end())
+	{
+		return(iter->second);
+	}
+
+	return(InvalidMaterialHandle);
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files,
+ *  configuring the texture mapping parameters in OpenGL,
+ *  generating the mipmaps, and loading the read texture into
+ *  the next available texture slot in memory.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, const std::string& tag)
+{
+	DECODED_TEXTURE decoded;
+
+	// block-compressed containers are selected automatically
+	// by file extension and take the pre-baked mip chain path
+	if (IsDDSFile(filename))
+	{
+		return CreateGLTextureFromDDS(filename, tag);
+	}
+
+	decoded.filename = filename;
+	decoded.tag = tag;
+	decoded.pixels = NULL;
+	decoded.width = 0;
+	decoded.height = 0;
+	decoded.colorChannels = 0;
+
+	// indicate to always flip images vertically when loaded
+	stbi_set_flip_vertically_on_load(true);
+
+	// decode the image file and upload the pixel data - the
+	// two stages are split so LoadSceneTextures() can run the
+	// decodes on worker threads
+	if (DecodeTextureImage(decoded) == false)
+	{
+		return false;
+	}
+
+	return CreateGLTextureFromDecoded(decoded);
+}
+
+/***********************************************************
+ *  DecodeTextureImage()
+ *
+ *  This method is used for decoding a texture image file
+ *  into pixel data in memory.  It does no OpenGL work, so
+ *  it is safe to call from worker threads.
+ ***********************************************************/
+bool SceneManager::DecodeTextureImage(DECODED_TEXTURE& decoded)
+{
+	// try to parse the image data from the specified image file
+	decoded.pixels = stbi_load(
+		decoded.filename.c_str(),
+		&decoded.width,
+		&decoded.height,
+		&decoded.colorChannels,
+		0);
+
+	if (NULL == decoded.pixels)
+	{
+		std::cout << "Could not load image:" << decoded.filename << std::endl;
+		return false;
+	}
+
+	std::cout << "Successfully loaded image:" << decoded.filename << ", width:" << decoded.width << ", height:" << decoded.height << ", channels:" << decoded.colorChannels << std::endl;
+
+	return true;
+}
+
+/***********************************************************
+ *  CreateGLTextureFromDecoded()
+ *
+ *  This method is used for uploading decoded pixel data
+ *  into an OpenGL texture.  The data is staged through a
+ *  pixel buffer object so the transfer to the GPU can run
+ *  asynchronously.  Must be called on the main thread that
+ *  owns the OpenGL context.
+ ***********************************************************/
+bool SceneManager::CreateGLTextureFromDecoded(DECODED_TEXTURE& decoded)
+{
+	GLuint textureID = 0;
+	GLuint pboID = 0;
+	GLsizeiptr imageSize = 0;
+
+	if (NULL == decoded.pixels)
+	{
+		return false;
+	}
+	if ((decoded.colorChannels != 3) && (decoded.colorChannels != 4))
+	{
+		std::cout << "Not implemented to handle image with " << decoded.colorChannels << " channels" << std::endl;
+		stbi_image_free(decoded.pixels);
+		decoded.pixels = NULL;
+		return false;
+	}
+
+	// stage the pixel data into a pixel buffer object - with
+	// the PBO bound, glTexImage2D() sources its data from the
+	// buffer and returns without waiting for the transfer
+	imageSize = (GLsizeiptr)decoded.width * decoded.height * decoded.colorChannels;
+	glGenBuffers(1, &pboID);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboID);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, imageSize, decoded.pixels, GL_STREAM_DRAW);
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// tightly packed rows - 3 channel images are not 4 byte aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// if the loaded image is in RGB format
+	if (decoded.colorChannels == 3)
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, decoded.width, decoded.height, 0, GL_RGB, GL_UNSIGNED_BYTE, (void*)0);
+	// if the loaded image is in RGBA format - it supports transparency
+	else
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, decoded.width, decoded.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// generate the texture mipmaps for mapping textures to lower resolutions
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	// the pixel data has been handed off to the PBO, so the
+	// decoded image and the staging buffer can be released
+	stbi_image_free(decoded.pixels);
+	decoded.pixels = NULL;
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glDeleteBuffers(1, &pboID);
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	// register the loaded texture and associate it with the special tag string
+	m_textureIDs[m_loadedTextures].ID = textureID;
+	m_textureIDs[m_loadedTextures].tag = decoded.tag;
+	// intern the tag into the texture registry so later
+	// lookups are a single hash probe
+	m_textureRegistry[decoded.tag] = m_loadedTextures;
+	m_loadedTextures++;
+
+	return true;
+}
+
+/***********************************************************
+ *  CreateGLTextureFromDDS()
+ *
+ *  This method is used for loading a DDS texture container
+ *  holding a block-compressed image (BC1/BC3/BC7) with a
+ *  pre-baked mip chain.  The compressed levels are uploaded
+ *  directly with glCompressedTexImage2D(), so no runtime
+ *  mipmap generation is needed and the texture stays
+ *  compressed in VRAM.  DDS images are stored top-down, so
+ *  the assets must be exported vertically flipped to match
+ *  the orientation of the stbi path.
+ ***********************************************************/
+bool SceneManager::CreateGLTextureFromDDS(const char* filename, const std::string& tag)
+{
+	GLuint textureID = 0;
+	GLenum internalFormat = 0;
+	uint32_t blockSize = 0;
+	uint32_t magic = 0;
+	DDS_HEADER header;
+	DDS_HEADER_DXT10 header10;
+
+	// read the container file into memory
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return false;
+	}
+
+	file.read((char*)&magic, sizeof(magic));
+	file.read((char*)&header, sizeof(header));
+	if (!file || (magic != g_DDSMagic) || (header.size != sizeof(header)))
+	{
+		std::cout << "Not a valid DDS file:" << filename << std::endl;
+		return false;
+	}
+
+	// map the stored format onto the matching GL compressed
+	// internal format - BC1 packs 8 bytes per 4x4 block, BC3
+	// and BC7 pack 16
+	if (header.ddspf.fourCC == g_FourCC_DXT1)
+	{
+		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		blockSize = 8;
+	}
+	else if (header.ddspf.fourCC == g_FourCC_DXT5)
+	{
+		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		blockSize = 16;
+	}
+	else if (header.ddspf.fourCC == g_FourCC_DX10)
+	{
+		file.read((char*)&header10, sizeof(header10));
+		if (!file || (header10.dxgiFormat != g_DXGIFormatBC7Unorm))
+		{
+			std::cout << "Unsupported DDS DX10 format in:" << filename << std::endl;
+			return false;
+		}
+		internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+		blockSize = 16;
+	}
+	else
+	{
+		std::cout << "Unsupported DDS format in:" << filename << std::endl;
+		return false;
+	}
+
+	// read the compressed mip chain that follows the headers
+	std::vector<unsigned char> mipData(
+		(std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - sample the pre-baked
+	// mip chain when the container holds more than one level
+	uint32_t mipMapCount = (header.mipMapCount > 0) ? header.mipMapCount : 1;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+		(mipMapCount > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipMapCount - 1);
+
+	// upload each compressed level directly - no runtime
+	// mipmap generation is needed
+	uint32_t width = header.width;
+	uint32_t height = header.height;
+	size_t offset = 0;
+	for (uint32_t level = 0; level < mipMapCount; level++)
+	{
+		uint32_t levelSize =
+			((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+		if (offset + levelSize > mipData.size())
+		{
+			std::cout << "Truncated DDS mip chain in:" << filename << std::endl;
+			glDeleteTextures(1, &textureID);
+			return false;
+		}
+		glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat,
+			width, height, 0, levelSize, &mipData[offset]);
+		offset += levelSize;
+		width = (width > 1) ? (width / 2) : 1;
+		height = (height > 1) ? (height / 2) : 1;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	std::cout << "Successfully loaded image:" << filename << ", width:" << header.width << ", height:" << header.height << ", mips:" << mipMapCount << std::endl;
+
+	// register the loaded texture and associate it with the special tag string
+	m_textureIDs[m_loadedTextures].ID = textureID;
+	m_textureIDs[m_loadedTextures].tag = tag;
+	// intern the tag into the texture registry so later
+	// lookups are a single hash probe
+	m_textureRegistry[tag] = m_loadedTextures;
+	m_loadedTextures++;
+
+	return true;
+}
+
+/***********************************************************
+ *  BuildTextureAtlas()
+ *
+ *  This method packs the small decoded texture images into
+ *  a single atlas texture on a uniform grid and records the
+ *  UV sub-rectangle for each packed tag.  All of the packed
+ *  tags resolve to the one atlas slot, so objects that use
+ *  them batch together without any sampler switches.  The
+ *  atlas has no mipmaps and samples with a half-texel inset
+ *  so neighboring tiles do not bleed into each other.
+ ***********************************************************/
+void SceneManager::BuildTextureAtlas(std::vector<DECODED_TEXTURE>& decodedTextures)
+{
+	std::vector<int> packedIndices;
+	GLuint atlasID = 0;
+	int cellSize = 0;
+	int columns = 0;
+	int rows = 0;
+	int atlasWidth = 0;
+	int atlasHeight = 0;
+
+	// collect the decoded images that are small enough to pack -
+	// large images keep their own texture objects so they can
+	// still tile with GL_REPEAT
+	for (int i = 0; i < (int)decodedTextures.size(); i++)
+	{
+		DECODED_TEXTURE& decoded = decodedTextures[i];
+
+		if (NULL == decoded.pixels)
+		{
+			continue;
+		}
+		if ((decoded.colorChannels != 3) && (decoded.colorChannels != 4))
+		{
+			continue;
+		}
+		if ((decoded.width > g_AtlasMaxTileSize) ||
+			(decoded.height > g_AtlasMaxTileSize))
+		{
+			continue;
+		}
+
+		packedIndices.push_back(i);
+		if (decoded.width > cellSize)
+		{
+			cellSize = decoded.width;
+		}
+		if (decoded.height > cellSize)
+		{
+			cellSize = decoded.height;
+		}
+	}
+
+	// an atlas with fewer than two tiles saves nothing
+	if (packedIndices.size() < 2)
+	{
+		return;
+	}
+
+	// lay the tiles out on a near-square uniform grid sized by
+	// the largest packed tile
+	columns = 1;
+	while (columns * columns < (int)packedIndices.size())
+	{
+		columns++;
+	}
+	rows = ((int)packedIndices.size() + columns - 1) / columns;
+	atlasWidth = columns * cellSize;
+	atlasHeight = rows * cellSize;
+
+	// compose the atlas image in memory - everything is widened
+	// to RGBA so mixed 3 and 4 channel sources can share it
+	std::vector<unsigned char> atlasPixels(
+		(size_t)atlasWidth * atlasHeight * 4, 255);
+
+	for (int i = 0; i < (int)packedIndices.size(); i++)
+	{
+		DECODED_TEXTURE& decoded = decodedTextures[packedIndices[i]];
+		int cellX = (i % columns) * cellSize;
+		int cellY = (i / columns) * cellSize;
+
+		for (int y = 0; y < decoded.height; y++)
+		{
+			for (int x = 0; x < decoded.width; x++)
+			{
+				const unsigned char* pSource = decoded.pixels +
+					((size_t)y * decoded.width + x) * decoded.colorChannels;
+				unsigned char* pDest = &atlasPixels[
+					(((size_t)(cellY + y) * atlasWidth) + cellX + x) * 4];
+
+				pDest[0] = pSource[0];
+				pDest[1] = pSource[1];
+				pDest[2] = pSource[2];
+				pDest[3] = (decoded.colorChannels == 4) ? pSource[3] : 255;
+			}
+		}
+
+		// record the UV sub-rectangle for the packed tag with a
+		// half-texel inset on each side so linear filtering does
+		// not sample into the neighboring tile
+		ATLAS_REGION region;
+		region.uvOffset = glm::vec2(
+			(cellX + 0.5f) / (float)atlasWidth,
+			(cellY + 0.5f) / (float)atlasHeight);
+		region.uvScale = glm::vec2(
+			(decoded.width - 1.0f) / (float)atlasWidth,
+			(decoded.height - 1.0f) / (float)atlasHeight);
+		m_atlasRegions[decoded.tag] = region;
+
+		// the tile has been copied into the atlas image, so the
+		// decoded source can be released - the upload loop in
+		// LoadSceneTextures() skips freed images
+		stbi_image_free(decoded.pixels);
+		decoded.pixels = NULL;
+	}
+
+	glGenTextures(1, &atlasID);
+	glBindTexture(GL_TEXTURE_2D, atlasID);
+
+	// the packed tiles cannot tile, so the atlas clamps - and it
+	// has no mipmaps, since downsampled levels would blend the
+	// tiles into each other across their shared borders
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0,
+		GL_RGBA, GL_UNSIGNED_BYTE, &atlasPixels[0]);
+
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	// register the atlas texture and point every packed tag at
+	// its slot - tag lookups stay a single hash probe and the
+	// hot path never knows the atlas exists
+	m_textureIDs[m_loadedTextures].ID = atlasID;
+	m_textureIDs[m_loadedTextures].tag = "atlas";
+	for (int i = 0; i < (int)packedIndices.size(); i++)
+	{
+		m_textureRegistry[decodedTextures[packedIndices[i]].tag] = m_loadedTextures;
+	}
+	m_loadedTextures++;
+
+	std::cout << "INFO: packed " << packedIndices.size()
+		<< " textures into a " << atlasWidth << "x" << atlasHeight
+		<< " atlas" << std::endl;
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture memory slots.  There are up to 16 slots.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		// bind textures on corresponding texture units
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		// the atlas texture registers itself into this table
+		// like any other texture, so it is released here too
+		glDeleteTextures(1, &m_textureIDs[i].ID);
+		m_textureIDs[i].ID = 0;
+	}
+	m_loadedTextures = 0;
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const std::string& tag)
+{
+	int textureSlot = -1;
+
+	// resolve the tag through the texture registry
+	textureSlot = FindTextureSlot(tag);
+	if (textureSlot < 0)
+	{
+		return(-1);
+	}
+
+	return(m_textureIDs[textureSlot].ID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ *  The tags are interned into a hash registry when the
+ *  textures are loaded, so the lookup is a single hash
+ *  probe instead of a linear string scan.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const std::string& tag)
+{
+	std::unordered_map<std::string, TextureHandle>::const_iterator
+		iter = m_textureRegistry.find(tag);
+	if (iter != m_textureRegistry.end())
+	{
+		return(iter->second);
+	}
+
+	return(InvalidTextureHandle);
+}
+
+/***********************************************************
+ *  BuildModelMatrix()
+ *
+ *  This method is used for building the model matrix for
+ *  an object from the passed in transformation values.
+ ***********************************************************/
+glm::mat4 SceneManager::BuildModelMatrix(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	// set the scale value in the transform buffer
+	scale = glm::scale(scaleXYZ);
+	// set the rotation values in the transform buffer
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	// set the translation value in the transform buffer
+	translation = glm::translate(positionXYZ);
+
+	return(translation * rotationX * rotationY * rotationZ * scale);
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+ /***********************************************************
+  *  LoadSceneTextures()
+  *
+  *  This method is used for preparing the 3D scene by loading
+  *  the shapes, textures in memory to support the 3D scene
+  *  rendering
+  ***********************************************************/
+void SceneManager::LoadSceneTextures()
+{
+	/*** STUDENTS - add the code BELOW for loading the textures that ***/
+	/*** will be used for mapping to objects in the 3D scene. Up to  ***/
+	/*** 16 textures can be loaded per scene. Refer to the code in   ***/
+	/*** the OpenGL Sample for help.                                 ***/
+	//load the various textures for the pyramid structure and different object meshes
+	//
+	// offline migration note: these assets should move to
+	// block-compressed DDS containers with pre-baked mips -
+	// the loader already picks the format by extension.
+	// all nine are opaque albedo maps, so BC1 (DXT1) is the
+	// right target for each of them; if we ever add decals
+	// or images with alpha, export those as BC3 or BC7
+	const char* textureFiles[][2] =
+	{
+		{ "textures/plastic.jpg", "plastic" },
+		{ "textures/wood.jpg",    "wood" },
+		{ "textures/red.jpg",     "red" },
+		{ "textures/grip.jpg",    "grip" },
+		{ "textures/brick.jpg",   "brick" },
+		{ "textures/blue.jpg",    "blue" },
+		{ "textures/silver.jpg",  "silver" },
+		{ "textures/yellow.jpg",  "yellow" },
+		{ "textures/metal2.jpg",  "metal2" },
+	};
+	const int textureCount = sizeof(textureFiles) / sizeof(textureFiles[0]);
+
+	std::vector<DECODED_TEXTURE> decodedTextures(textureCount);
+	std::vector<std::thread> workers;
+	std::atomic<int> nextTexture(0);
+	int workerCount = 0;
+
+	// set the global decode options on the main thread before
+	// the worker threads start reading them
+	stbi_set_flip_vertically_on_load(true);
+
+	for (int i = 0; i < textureCount; i++)
+	{
+		decodedTextures[i].filename = textureFiles[i][0];
+		decodedTextures[i].tag = textureFiles[i][1];
+		decodedTextures[i].pixels = NULL;
+		decodedTextures[i].width = 0;
+		decodedTextures[i].height = 0;
+		decodedTextures[i].colorChannels = 0;
+	}
+
+	// fan the image decodes out across worker threads - the
+	// decode stage does no OpenGL work, so only the uploads
+	// below have to run on the main thread
+	StartupProfiler::BeginPhase("image decode");
+	workerCount = (int)std::thread::hardware_concurrency();
+	if (workerCount < 1)
+	{
+		workerCount = 1;
+	}
+	if (workerCount > textureCount)
+	{
+		workerCount = textureCount;
+	}
+	for (int i = 0; i < workerCount; i++)
+	{
+		workers.push_back(std::thread([&decodedTextures, &nextTexture, textureCount]()
+		{
+			int index = nextTexture.fetch_add(1);
+			while (index < textureCount)
+			{
+				// compressed containers skip the decode stage -
+				// they are read straight from disk at upload time
+				if (!IsDDSFile(decodedTextures[index].filename))
+				{
+					DecodeTextureImage(decodedTextures[index]);
+				}
+				index = nextTexture.fetch_add(1);
+			}
+		}));
+	}
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+	StartupProfiler::EndPhase();
+
+	// pack the small uniform textures into one atlas texture -
+	// the packed tags all resolve to the shared atlas slot, so
+	// most of the scene renders without any sampler switches
+	StartupProfiler::BeginPhase("atlas build");
+	BuildTextureAtlas(decodedTextures);
+	StartupProfiler::EndPhase();
+
+	// upload the remaining decoded images in declaration order
+	// so the texture slot assignments stay deterministic - the
+	// atlased images were consumed above and are skipped here
+	StartupProfiler::BeginPhase("texture upload");
+	for (int i = 0; i < textureCount; i++)
+	{
+		if (IsDDSFile(decodedTextures[i].filename))
+		{
+			StartupProfiler::BeginPhase(decodedTextures[i].filename.c_str());
+			CreateGLTextureFromDDS(
+				decodedTextures[i].filename.c_str(),
+				decodedTextures[i].tag);
+			StartupProfiler::EndPhase();
+		}
+		else if (NULL != decodedTextures[i].pixels)
+		{
+			StartupProfiler::BeginPhase(decodedTextures[i].filename.c_str());
+			CreateGLTextureFromDecoded(decodedTextures[i]);
+			StartupProfiler::EndPhase();
+		}
+	}
+	StartupProfiler::EndPhase();
+
+	// after the texture image data is loaded into memory, the
+	// loaded textures need to be bound to texture slots - there
+	// are a total of 16 available slots for scene textures
+	BindGLTextures();
+}
+
+/***********************************************************
+ *  UploadMaterialBuffer()
+ *
+ *  This method uploads the defined object materials into
+ *  the material uniform buffer object.  The fragment shader
+ *  indexes into this table with the per-object material
+ *  index, so the material properties are sent to the GPU
+ *  only once instead of being set per draw call.
+ ***********************************************************/
+void SceneManager::UploadMaterialBuffer()
+{
+	MATERIAL_DATA materialData[g_MaxMaterials];
+	int materialCount = 0;
+
+	// mirror the defined materials into the std140 layout
+	// that the fragment shader expects
+	memset(materialData, 0, sizeof(materialData));
+	materialCount = (int)m_objectMaterials.size();
+	if (materialCount > g_MaxMaterials)
+	{
+		std::cout << "Too many materials defined, only "
+			<< g_MaxMaterials << " are uploaded" << std::endl;
+		materialCount = g_MaxMaterials;
+	}
+	for (int i = 0; i < materialCount; i++)
+	{
+		materialData[i].ambientStrength = m_objectMaterials[i].ambientStrength;
+		materialData[i].ambientColor = m_objectMaterials[i].ambientColor;
+		materialData[i].diffuseColor = m_objectMaterials[i].diffuseColor;
+		materialData[i].specularColor = m_objectMaterials[i].specularColor;
+		materialData[i].shininess = m_objectMaterials[i].shininess;
+		// intern the tag into the material registry so later
+		// lookups are a single hash probe
+		m_materialRegistry[m_objectMaterials[i].tag] = i;
+	}
+
+	// create the uniform buffer on first use and upload the
+	// full material table in a single call
+	if (0 == m_materialsUBO)
+	{
+		glGenBuffers(1, &m_materialsUBO);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, m_materialsUBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(materialData), materialData, GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// attach the buffer to the material block binding point
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_MaterialBlockBinding, m_materialsUBO);
+}
+
+/***********************************************************
+ *  DefineObjectMaterials()
+ *
+ *  This method is used for configuring the various material
+ *  settings for all of the objects within the 3D scene.
+ ***********************************************************/
+void SceneManager::DefineObjectMaterials()
+{
+	/*** STUDENTS - add the code BELOW for defining object materials. ***/
+	/*** There is no limit to the number of object materials that can ***/
+	/*** be defined. Refer to the code in the OpenGL Sample for help  ***/
+	OBJECT_MATERIAL goldMaterial; //first more reflective materal
+	goldMaterial.ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	goldMaterial.ambientStrength = 5.0f;
+	goldMaterial.diffuseColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	goldMaterial.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
+	goldMaterial.shininess = 12.0;
+	goldMaterial.tag = "metal";
+
+	m_objectMaterials.push_back(goldMaterial);
+
+	OBJECT_MATERIAL woodMaterial; //second less reflective materal
+	woodMaterial.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	woodMaterial.ambientStrength = 2.0f;
+	woodMaterial.diffuseColor = glm::vec3(0.3f, 0.3f, 0.3f);
+	woodMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	woodMaterial.shininess = 4.0;
+	woodMaterial.tag = "wood";
+
+	m_objectMaterials.push_back(woodMaterial);
+
+	OBJECT_MATERIAL plasticMaterial; //third least reflective materal
+	plasticMaterial.ambientColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	plasticMaterial.ambientStrength = 1.5f;
+	plasticMaterial.diffuseColor = glm::vec3(0.3f, 0.3f, 0.3f);
+	plasticMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
+	plasticMaterial.shininess = 1.0;
+	plasticMaterial.tag = "plastic";
+
+	m_objectMaterials.push_back(plasticMaterial);
+
+	// upload the defined materials into the material uniform
+	// buffer so the shader can index into the table
+	UploadMaterialBuffer();
+}
+
+/***********************************************************
+ *  SetupSceneLights()
+ *
+ *  This method is called to add and configure the light
+ *  sources for the 3D scene.  There are up to 4 light sources.
+ ***********************************************************/
+void SceneManager::SetupSceneLights()
+{
+	LIGHT_DATA lightData[4];
+
+	// fill in the std140 mirror of the light source array -
+	// the light setup is static, so the whole array is sent
+	// to the GPU once in a single buffer upload instead of
+	// 24 individual uniform calls
+	memset(lightData, 0, sizeof(lightData));
+
+	lightData[0].position = glm::vec3(0.0f, 10.0f, 20.0f);
+	lightData[0].ambientColor = glm::vec3(0.3f, 0.3f, 0.3f);
+	lightData[0].diffuseColor = glm::vec3(0.4f, 0.4f, 0.4f);
+	lightData[0].specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	lightData[0].focalStrength = 42.0f;
+	lightData[0].specularIntensity = 0.05f;
+
+	lightData[1].position = glm::vec3(-15.0f, 10.0f, -15.0f);
+	lightData[1].ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	lightData[1].diffuseColor = glm::vec3(0.4f, 0.4f, 0.4f);
+	lightData[1].specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	lightData[1].focalStrength = 38.0f;
+	lightData[1].specularIntensity = 0.05f;
+
+	lightData[2].position = glm::vec3(20.0f, 10.0f, 1.0f);
+	lightData[2].ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	lightData[2].diffuseColor = glm::vec3(0.3f, 0.3f, 0.3f);
+	lightData[2].specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	lightData[2].focalStrength = 74.0f;
+	lightData[2].specularIntensity = 0.05f;
+
+	lightData[3].position = glm::vec3(0.0f, 0.0f, -25.0f);
+	lightData[3].ambientColor = glm::vec3(0.2f, 0.2f, 0.2f);
+	lightData[3].diffuseColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	lightData[3].specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	lightData[3].focalStrength = 26.0f;
+	lightData[3].specularIntensity = 0.05f;
+
+	// create the uniform buffer on first use and upload the
+	// full light source array in a single call
+	if (0 == m_lightsUBO)
+	{
+		glGenBuffers(1, &m_lightsUBO);
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, m_lightsUBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(lightData), lightData, GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// attach the buffer to the light block binding point
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_LightBlockBinding, m_lightsUBO);
+
+	// capture the light positions for the shadow map renders
+	// and invalidate every cached map - a light definition
+	// change is exactly what the invalidation exists for
+	m_lightCount = 4;
+	for (int light = 0; light < m_lightCount; light++)
+	{
+		m_lightPositions[light] = lightData[light].position;
+		InvalidateShadowMap(light);
+	}
+
+	// bake the active light count into the lit shader variant
+	// and make it the active program - the runtime lighting
+	// branch the shaders used to have is gone
+	m_pShaderManager->SetActiveLightCount(4);
+	m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_LIT);
+}
+
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene
+ *  rendering
+ ***********************************************************/
+void SceneManager::PrepareScene()
+{
+	// load the textures for the 3D scene
+	StartupProfiler::BeginPhase("texture load");
+	LoadSceneTextures();
+	StartupProfiler::EndPhase();
+
+	// define the object materials that are used for lighting
+	StartupProfiler::BeginPhase("material and light setup");
+	DefineObjectMaterials();
+
+	// add and defile the light sources for the 3D scene
+	SetupSceneLights();
+	StartupProfiler::EndPhase();
+
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene - the tessellated meshes are
+	// generated on worker threads
+	StartupProfiler::BeginPhase("mesh generation");
+	m_basicMeshes->LoadAllMeshes();
+	StartupProfiler::EndPhase();
+
+	StartupProfiler::BeginPhase("scene build");
+
+	// build the retained scene object list once - the model
+	// matrices and texture/material handles are resolved here
+	// so RenderScene() does not redo that work every frame.
+	// a binary scene file is read straight into the object
+	// array when one exists; otherwise the built-in scene is
+	// defined in code and written out for the next launch
+	if (!LoadSceneBinary())
+	{
+		BuildSceneObjects();
+		SaveSceneBinary();
+	}
+
+	// group the scene objects into instanced draw batches so
+	// repeated meshes with identical state are submitted with
+	// a single draw call each frame
+	BuildDrawBatches();
+
+	// upload the per-batch shader state into the draw state
+	// storage buffer - the fragment shader indexes it with
+	// the draw ID, so replaying a frame needs no per-draw
+	// uniform calls at all
+	UploadDrawStateBuffer();
+
+	// create the proxy mesh and the per-instance query objects
+	// for the occlusion culling mode
+	if (g_OcclusionCulling)
+	{
+		PrepareOcclusionQueries();
+	}
+
+	StartupProfiler::EndPhase();
+}
+
+/***********************************************************
+ *  AddSceneObject()
+ *
+ *  This method is used for adding one retained draw record
+ *  into the scene object list.  The model matrix is computed
+ *  here and the texture/material tags are resolved into
+ *  handles so no per-frame lookups are needed.
+ ***********************************************************/
+void SceneManager::AddSceneObject(
+	MESH_ID meshID,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ,
+	glm::vec4 color,
+	const std::string& textureTag,
+	glm::vec2 uvScale,
+	const std::string& materialTag)
+{
+	SCENE_OBJECT sceneObject;
+
+	sceneObject.meshID = meshID;
+	// precompute the model matrix once for the static object
+	sceneObject.modelMatrix = BuildModelMatrix(
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+	sceneObject.color = color;
+	// resolve the texture tag into a texture slot
+	sceneObject.bUseTexture = !textureTag.empty();
+	sceneObject.textureSlot = sceneObject.bUseTexture ?
+		FindTextureSlot(textureTag) : -1;
+	sceneObject.uvScale = uvScale;
+	sceneObject.uvOffset = glm::vec2(0.0f, 0.0f);
+	// if the texture was packed into the atlas, fold its UV
+	// sub-rectangle into the per-object UV transform - the
+	// shader applies scale then offset, so the tag's region
+	// composes with the requested tiling scale
+	if (sceneObject.bUseTexture)
+	{
+		std::unordered_map<std::string, ATLAS_REGION>::iterator atlasRegion =
+			m_atlasRegions.find(textureTag);
+		if (atlasRegion != m_atlasRegions.end())
+		{
+			// the atlas cannot wrap, so tiling scales larger than
+			// one are clamped - invisible on the near-uniform
+			// swatches that get packed, and textures that really
+			// tile stay out of the atlas by size
+			glm::vec2 tiling = glm::min(uvScale, glm::vec2(1.0f, 1.0f));
+			sceneObject.uvScale = tiling * atlasRegion->second.uvScale;
+			sceneObject.uvOffset = atlasRegion->second.uvOffset;
+		}
+	}
+	// resolve the material tag into a material index - fall
+	// back to the first material when the tag is not found so
+	// the shader never indexes outside the material table
+	sceneObject.materialIndex = FindMaterialIndex(materialTag);
+	if (sceneObject.materialIndex < 0)
+	{
+		sceneObject.materialIndex = 0;
+	}
+
+	// precompute the world-space bounding sphere for the
+	// frustum cull pass - the mesh-local sphere is moved by
+	// the model matrix and the radius grows by the largest
+	// scale axis
+	glm::vec4 localBounds = g_MeshBounds[meshID];
+	glm::vec3 boundsCenter = glm::vec3(sceneObject.modelMatrix *
+		glm::vec4(glm::vec3(localBounds), 1.0f));
+	float maxScale = glm::length(glm::vec3(sceneObject.modelMatrix[0]));
+	maxScale = glm::max(maxScale, glm::length(glm::vec3(sceneObject.modelMatrix[1])));
+	maxScale = glm::max(maxScale, glm::length(glm::vec3(sceneObject.modelMatrix[2])));
+	sceneObject.bounds = glm::vec4(boundsCenter, localBounds.w * maxScale);
+
+	m_sceneObjects.push_back(sceneObject);
+}
+
+/***********************************************************
+ *  BuildSceneObjects()
+ *
+ *  This method is used for building the retained scene
+ *  object list.  It is called once from PrepareScene() -
+ *  every transform, texture and material below is resolved
+ *  here instead of being recomputed each frame.
+ ***********************************************************/
+void SceneManager::BuildSceneObjects()
+{
+	/*** Set needed transformations before drawing the basic mesh.  ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and drawing all the basic 3D shapes.						***/
+	/******************************************************************/
+	// the table surface plane
+	AddSceneObject(MESH_PLANE,
+		glm::vec3(25.0f, 5.0f, 20.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-7.0f, 0.0f, -7.0f),
+		glm::vec4(1.0f, 0.540f, 0.540f, 0.540f), "wood", glm::vec2(1.0f, 1.0f), "wood");
+
+	// OBJECT 1: Flashlight
+	// first cylinder flashlight base
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.0f, 4.0f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 0.0f, 0.0f),
+		glm::vec4(0.184f, 0.310f, 0.310f, 1.0f), "plastic", glm::vec2(1.0f, 1.0f), "metal");
+	// cylinder for flashlight grip
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.0f, 2.0f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 4.0f, 0.0f),
+		glm::vec4(0.502f, 0.502f, 0.502f, 1.0f), "grip", glm::vec2(0.5f, 0.5f), "wood");
+	// second cylinder for base of flashlight after grip
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.0f, 1.0f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 6.0f, 0.0f),
+		glm::vec4(0.184f, 0.310f, 0.310f, 1.0f), "plastic", glm::vec2(1.0f, 1.0f), "metal");
+	// third base cylinder tapering off slightly
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(0.8f, 3.0f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 7.0f, 0.0f),
+		glm::vec4(0.184f, 0.310f, 0.310f, 1.0f), "plastic", glm::vec2(1.0f, 1.0f), "metal");
+	// fourth cylinder for base back to original width near battery compartment
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.0f, 1.7f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 10.0f, 0.0f),
+		glm::vec4(0.184f, 0.310f, 0.310f, 1.0f), "plastic", glm::vec2(1.0f, 1.0f), "metal");
+	// fifth cylinder for the flashlight button
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(0.7f, 0.3f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(0.0f, 11.6f, 0.0f),
+		glm::vec4(1.0f), "red", glm::vec2(2.0f, 2.0f), "wood");
+	// first box representing the flashlight belt clip
+	AddSceneObject(MESH_BOX,
+		glm::vec3(0.8f, 0.1f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(1.3f, 11.0f, 0.0f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+	// second box representing the flashlight belt clip
+	AddSceneObject(MESH_BOX,
+		glm::vec3(0.3f, 4.0f, 0.5f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(1.5f, 9.0f, 0.0f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+
+	// OBJECT 2: Card Box
+	AddSceneObject(MESH_BOX,
+		glm::vec3(12.0f, 14.0f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-12.0f, 7.2f, -12.0f),
+		glm::vec4(1.0f), "blue", glm::vec2(0.1f, 0.1f), "plastic");
+	// card box logo using cones
+	AddSceneObject(MESH_CONE,
+		glm::vec3(1.5f, 2.9f, 0.1f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-12.0f, 9.8f, -7.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+	// card box logo using cones 2
+	AddSceneObject(MESH_CONE,
+		glm::vec3(1.5f, 2.9f, 0.1f), 0.0f, 0.0f, 60.0f,
+		glm::vec3(-14.0f, 9.0f, -7.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+	// card box logo using cones 3
+	AddSceneObject(MESH_CONE,
+		glm::vec3(1.5f, 2.9f, 0.1f), 0.0f, 0.0f, -60.0f,
+		glm::vec3(-10.6f, 9.0f, -7.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+	// card box logo using cones 4
+	AddSceneObject(MESH_CONE,
+		glm::vec3(1.5f, 2.9f, 0.1f), 0.0f, 0.0f, -150.0f,
+		glm::vec3(-11.2f, 7.4f, -7.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+	// card box logo using cones 5
+	AddSceneObject(MESH_CONE,
+		glm::vec3(1.5f, 2.9f, 0.1f), 0.0f, 0.0f, 150.0f,
+		glm::vec3(-13.3f, 7.4f, -7.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+	// card box logo using cylinder
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(2.5f, 0.3f, 2.5f), 0.0f, 90.0f, 90.0f,
+		glm::vec3(-12.3f, 8.4f, -7.2f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "wood");
+
+	// OBJECT 3: Wallet
+	// bottom of metallic wallet
+	AddSceneObject(MESH_BOX,
+		glm::vec3(8.0f, 0.4f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(6.0f, 0.6f, -13.0f),
+		glm::vec4(1.0f), "metal2", glm::vec2(0.1f, 0.1f), "wood");
+	// middle of wallet holding plastic cards - card 1
+	AddSceneObject(MESH_BOX,
+		glm::vec3(8.0f, 0.2f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(6.0f, 0.9f, -13.0f),
+		glm::vec4(1.0f), "red", glm::vec2(0.1f, 0.1f), "plastic");
+	// card 2
+	AddSceneObject(MESH_BOX,
+		glm::vec3(8.0f, 0.2f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(6.0f, 1.1f, -13.0f),
+		glm::vec4(1.0f), "blue", glm::vec2(0.1f, 0.1f), "plastic");
+	// card 3
+	AddSceneObject(MESH_BOX,
+		glm::vec3(8.0f, 0.2f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(6.0f, 1.3f, -13.0f),
+		glm::vec4(1.0f), "yellow", glm::vec2(0.1f, 0.1f), "plastic");
+	// top of metallic wallet
+	AddSceneObject(MESH_BOX,
+		glm::vec3(8.0f, 0.4f, 10.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(6.0f, 1.6f, -13.0f),
+		glm::vec4(1.0f), "metal2", glm::vec2(0.1f, 0.1f), "metal");
+	// elastic holding wallet together 1
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.4f, 4.4f, 0.1f), 0.0f, 0.0f, 90.0f,
+		glm::vec3(6.0f, 1.15f, -7.8f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+	// elastic holding wallet together 2
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.4f, 4.4f, 0.1f), 0.0f, 0.0f, 90.0f,
+		glm::vec3(6.0f, 1.15f, -18.1f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+	// elastic holding wallet together 3
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.4f, 3.0f, 0.1f), 0.0f, 90.0f, 90.0f,
+		glm::vec3(2.0f, 1.15f, -13.1f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+	// elastic holding wallet together 4
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.4f, 3.0f, 0.1f), 0.0f, 90.0f, 90.0f,
+		glm::vec3(10.0f, 1.15f, -13.1f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "wood");
+	// wallet logo
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.0f, 0.1f, 1.0f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(8.4f, 1.8f, -9.5f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "metal");
+
+	// OBJECT 4: Metallic silver watch
+	// watch face
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.7f, 0.3f, 1.7f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-13.0f, 0.5f, 2.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "metal");
+	// watch face border
+	AddSceneObject(MESH_CYLINDER,
+		glm::vec3(1.8f, 0.3f, 1.8f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-13.0f, 0.4f, 2.0f),
+		glm::vec4(1.0f), "metal2", glm::vec2(0.1f, 0.1f), "metal");
+	// watch button
+	AddSceneObject(MESH_SPHERE,
+		glm::vec3(0.2f, 0.1f, 0.2f), 0.0f, 90.0f, 90.0f,
+		glm::vec3(-12.85f, 0.54f, 3.8f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "plastic");
+	// watch link left
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.2f, 0.3f, 2.2f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-15.0f, 0.52f, 2.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "metal");
+	// watch link right
+	AddSceneObject(MESH_BOX,
+		glm::vec3(1.2f, 0.3f, 2.2f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-11.0f, 0.52f, 2.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "metal");
+	// watch band
+	AddSceneObject(MESH_BOX,
+		glm::vec3(10.5f, 0.3f, 1.8f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-13.0f, 0.2f, 2.0f),
+		glm::vec4(1.0f), "silver", glm::vec2(0.1f, 0.1f), "metal");
+	// watch face minute hand
+	AddSceneObject(MESH_BOX,
+		glm::vec3(0.1f, 0.1f, 1.2f), 0.0f, 30.0f, 0.0f,
+		glm::vec3(-13.2f, 0.9f, 1.8f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "plastic");
+	// watch face hour hand
+	AddSceneObject(MESH_BOX,
+		glm::vec3(0.1f, 0.1f, 0.7f), 0.0f, 0.0f, 0.0f,
+		glm::vec3(-12.9f, 0.9f, 1.9f),
+		glm::vec4(1.0f), "plastic", glm::vec2(0.1f, 0.1f), "plastic");
+}
+
+/***********************************************************
+ *  LoadSceneBinary()
+ *
+ *  This method is used for loading the retained scene object
+ *  list from the binary scene file.  The file holds the
+ *  fixed-size draw records exactly as they sit in memory, so
+ *  loading is one bulk read with zero parsing - swapping the
+ *  scene file swaps the whole scene without a recompile.
+ ***********************************************************/
+bool SceneManager::LoadSceneBinary()
+{
+	SCENE_FILE_HEADER header;
+
+	std::ifstream sceneFile(g_SceneFile, std::ios::binary);
+	if (!sceneFile.is_open())
+	{
+		return(false);
+	}
+
+	// validate the header - a version or record size mismatch
+	// means the file was written by a different build, so fall
+	// back to the scene defined in code
+	sceneFile.read((char*)&header, sizeof(header));
+	if (!sceneFile.good() ||
+		(header.magic != g_SceneFileMagic) ||
+		(header.version != g_SceneFileVersion) ||
+		(header.recordSize != (uint32_t)sizeof(SCENE_OBJECT)))
+	{
+		return(false);
+	}
+
+	// read the draw records straight into the object array
+	m_sceneObjects.resize(header.objectCount);
+	sceneFile.read((char*)m_sceneObjects.data(),
+		(std::streamsize)header.objectCount * sizeof(SCENE_OBJECT));
+	if (!sceneFile.good())
+	{
+		m_sceneObjects.clear();
+		return(false);
+	}
+
+	std::cout << "INFO: loaded " << header.objectCount
+		<< " scene objects from " << g_SceneFile << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveSceneBinary()
+ *
+ *  This method is used for writing the retained scene object
+ *  list out as the binary scene file, so the next launch
+ *  loads the scene as data instead of rebuilding it from the
+ *  code definition.
+ ***********************************************************/
+void SceneManager::SaveSceneBinary()
+{
+	SCENE_FILE_HEADER header;
+
+	std::ofstream sceneFile(g_SceneFile, std::ios::binary | std::ios::trunc);
+	if (!sceneFile.is_open())
+	{
+		return;
+	}
+
+	header.magic = g_SceneFileMagic;
+	header.version = g_SceneFileVersion;
+	header.recordSize = (uint32_t)sizeof(SCENE_OBJECT);
+	header.objectCount = (uint32_t)m_sceneObjects.size();
+
+	sceneFile.write((const char*)&header, sizeof(header));
+	sceneFile.write((const char*)m_sceneObjects.data(),
+		(std::streamsize)m_sceneObjects.size() * sizeof(SCENE_OBJECT));
+}
+
+/***********************************************************
+ *  BuildDrawBatches()
+ *
+ *  This method is used for grouping the retained scene
+ *  objects into instanced draw batches.  Objects that share
+ *  a mesh and identical shader state are collapsed into one
+ *  batch with per-instance model matrices and material
+ *  indices, so a batch of N objects is drawn with a single
+ *  instanced draw call.
+ ***********************************************************/
+void SceneManager::BuildDrawBatches()
+{
+	m_drawBatches.clear();
+
+	for (size_t index = 0; index < m_sceneObjects.size(); index++)
+	{
+		const SCENE_OBJECT& sceneObject = m_sceneObjects[index];
+
+		// look for an existing batch with matching mesh and
+		// shader state - the batch count stays small so a
+		// linear search is fine at scene preparation time
+		DRAW_BATCH* pBatch = NULL;
+		for (size_t batchIndex = 0; batchIndex < m_drawBatches.size(); batchIndex++)
+		{
+			DRAW_BATCH& batch = m_drawBatches[batchIndex];
+			if ((batch.meshID == sceneObject.meshID) &&
+				(batch.bUseTexture == sceneObject.bUseTexture) &&
+				(batch.textureSlot == sceneObject.textureSlot) &&
+				(batch.uvScale == sceneObject.uvScale) &&
+				(batch.uvOffset == sceneObject.uvOffset) &&
+				(batch.color == sceneObject.color))
+			{
+				pBatch = &batch;
+				break;
+			}
+		}
+
+		// start a new batch when no state match was found
+		if (NULL == pBatch)
+		{
+			DRAW_BATCH newBatch;
+			newBatch.meshID = sceneObject.meshID;
+			newBatch.bUseTexture = sceneObject.bUseTexture;
+			newBatch.color = sceneObject.color;
+			newBatch.textureSlot = sceneObject.textureSlot;
+			newBatch.uvScale = sceneObject.uvScale;
+			newBatch.uvOffset = sceneObject.uvOffset;
+			// pack the shader state into the sort key - most
+			// expensive switches in the highest bits, so the
+			// sorted order changes texture bindings least often
+			newBatch.sortKey =
+				((newBatch.bUseTexture ? 0u : 1u) << 31) |
+				((uint32_t)(newBatch.textureSlot + 1) << 16) |
+				((uint32_t)newBatch.meshID);
+			m_drawBatches.push_back(newBatch);
+			pBatch = &m_drawBatches.back();
+		}
+
+		// the material index travels with each instance, so
+		// objects with different materials can share a batch
+		ShapeMeshes::INSTANCE_DATA instance = {};
+		instance.modelMatrix = sceneObject.modelMatrix;
+		instance.materialIndex = sceneObject.materialIndex;
+		pBatch->instances.push_back(instance);
+		pBatch->bounds.push_back(sceneObject.bounds);
+	}
+
+	// order the batches by the packed state key once so the
+	// draw state table groups similar state together
+	std::stable_sort(m_drawBatches.begin(), m_drawBatches.end(),
+		[](const DRAW_BATCH& a, const DRAW_BATCH& b)
+		{
+			return(a.sortKey < b.sortKey);
+		});
+
+	// stamp each instance with its batch's index into the draw
+	// state table - the state rides with the instances, so the
+	// per-frame command order is free to change for depth
+	// sorting without touching the table
+	for (size_t batchIndex = 0; batchIndex < m_drawBatches.size(); batchIndex++)
+	{
+		DRAW_BATCH& batch = m_drawBatches[batchIndex];
+		for (size_t instance = 0; instance < batch.instances.size(); instance++)
+		{
+			batch.instances[instance].stateIndex = (int)batchIndex;
+		}
+	}
+
+	// reserve the per-frame scratch lists up front - the cull
+	// pass refills them every frame, and with the capacity in
+	// place here the steady-state frame performs zero heap
+	// allocations (watch the allocs counter in the frame stats)
+	size_t largestBatch = 0;
+	for (size_t batchIndex = 0; batchIndex < m_drawBatches.size(); batchIndex++)
+	{
+		if (m_drawBatches[batchIndex].instances.size() > largestBatch)
+		{
+			largestBatch = m_drawBatches[batchIndex].instances.size();
+		}
+	}
+	m_visibleInstances.reserve(largestBatch);
+	m_frameDraws.reserve(m_drawBatches.size());
+
+	std::cout << "INFO: Scene batched into " << m_drawBatches.size()
+		<< " draw calls for " << m_sceneObjects.size() << " objects" << std::endl;
+}
+
+/***********************************************************
+ *  UploadDrawStateBuffer()
+ *
+ *  This method uploads the per-batch shader state into the
+ *  draw state storage buffer.  The batches queue one draw
+ *  command each per frame, in order, so the draw ID of the
+ *  multi-draw-indirect frame indexes straight into this
+ *  table - the state that used to be set with per-draw
+ *  uniform calls is read by the fragment shader instead.
+ ***********************************************************/
+void SceneManager::UploadDrawStateBuffer()
+{
+	std::vector<DRAW_STATE_DATA> drawStates(m_drawBatches.size());
+
+	// mirror the sorted batch state into the std430 layout
+	// that the fragment shader expects
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		const DRAW_BATCH& batch = m_drawBatches[index];
+
+		drawStates[index].color = batch.color;
+		drawStates[index].uvScale = batch.uvScale;
+		drawStates[index].uvOffset = batch.uvOffset;
+		drawStates[index].bUseTexture = batch.bUseTexture ? 1 : 0;
+		drawStates[index].textureSlot =
+			(batch.textureSlot >= 0) ? batch.textureSlot : 0;
+		drawStates[index].padding[0] = 0;
+		drawStates[index].padding[1] = 0;
+	}
+
+	// create the storage buffer on first use and upload the
+	// full state table in a single call - the scene is static,
+	// so this never needs to be touched again
+	if (0 == m_drawStateSSBO)
+	{
+		glGenBuffers(1, &m_drawStateSSBO);
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawStateSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER,
+		drawStates.size() * sizeof(DRAW_STATE_DATA),
+		drawStates.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	// attach the buffer to the draw state block binding point -
+	// the binding index is fixed in the shader source
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, g_DrawStateBlockBinding,
+		m_drawStateSSBO);
+}
+
+/***********************************************************
+ *  InvalidateShadowMap()
+ *
+ *  This method marks one light's cached shadow map for a
+ *  re-render at the start of the next frame.  Call it when
+ *  that light or a caster in its volume changes - for the
+ *  static scene that only happens when the lights are set
+ *  up, so the maps render once and are sampled forever.
+ ***********************************************************/
+void SceneManager::InvalidateShadowMap(int lightIndex)
+{
+	if ((lightIndex >= 0) && (lightIndex < g_MaxLights))
+	{
+		m_shadowMapDirty[lightIndex] = true;
+	}
+}
+
+/***********************************************************
+ *  PrepareShadowResources()
+ *
+ *  This method creates the shadow map array texture, the
+ *  depth-only framebuffer and the shadow uniform buffers on
+ *  first use, and fits a bounding sphere around the whole
+ *  scene for the shadow frusta.
+ ***********************************************************/
+void SceneManager::PrepareShadowResources()
+{
+	if (0 != m_shadowFBO)
+	{
+		return;
+	}
+
+	// one depth layer per light, sampled through a hardware
+	// comparison sampler - fragments outside a map land on
+	// the border and read back as lit
+	glGenTextures(1, &m_shadowMapArray);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_shadowMapArray);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24,
+		g_ShadowMapSize, g_ShadowMapSize, g_MaxLights, 0,
+		GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	float borderDepth[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderDepth);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE,
+		GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	// the framebuffer carries depth only - no color buffer is
+	// ever attached to it
+	glGenFramebuffers(1, &m_shadowFBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_shadowFBO);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// the shadow matrix block the fragment shader samples
+	// with, and the stand-in camera block for the map renders
+	glGenBuffers(1, &m_shadowMatricesUBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_shadowMatricesUBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(m_shadowMatrices), NULL,
+		GL_STATIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_ShadowBlockBinding, m_shadowMatricesUBO);
+
+	glGenBuffers(1, &m_shadowCameraUBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_shadowCameraUBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(SHADOW_CAMERA_DATA), NULL,
+		GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// bind the map array to its dedicated texture unit - the
+	// scene textures occupy units 0 through 15
+	glActiveTexture(GL_TEXTURE0 + g_ShadowMapTextureUnit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_shadowMapArray);
+	glActiveTexture(GL_TEXTURE0);
+
+	// fit a bounding sphere around the retained scene - the
+	// per-light frusta are aimed at its center and sized to
+	// enclose it
+	glm::vec3 sceneCenter = glm::vec3(0.0f);
+	float sceneRadius = 1.0f;
+	if (!m_sceneObjects.empty())
+	{
+		for (size_t index = 0; index < m_sceneObjects.size(); index++)
+		{
+			sceneCenter += glm::vec3(m_sceneObjects[index].bounds);
+		}
+		sceneCenter /= (float)m_sceneObjects.size();
+		for (size_t index = 0; index < m_sceneObjects.size(); index++)
+		{
+			float reach = glm::length(
+				glm::vec3(m_sceneObjects[index].bounds) - sceneCenter) +
+				m_sceneObjects[index].bounds.w;
+			if (reach > sceneRadius)
+			{
+				sceneRadius = reach;
+			}
+		}
+	}
+	m_sceneBounds = glm::vec4(sceneCenter, sceneRadius);
+}
+
+/***********************************************************
+ *  RenderShadowMap()
+ *
+ *  This method renders one light's cached shadow map.  The
+ *  whole retained scene is drawn depth-only from the light's
+ *  point of view - the light's view and projection stand in
+ *  for the camera block, so the depth-only shader variant
+ *  renders the map without any dedicated shadow shader.
+ ***********************************************************/
+void SceneManager::RenderShadowMap(int lightIndex)
+{
+	glm::vec3 lightPosition = m_lightPositions[lightIndex];
+	glm::vec3 sceneCenter = glm::vec3(m_sceneBounds);
+	float sceneRadius = m_sceneBounds.w;
+	SHADOW_CAMERA_DATA cameraData;
+	GLint previousViewport[4] = { 0 };
+	GLint previousFramebuffer = 0;
+	GLint previousCameraUBO = 0;
+
+	// aim the light frustum at the scene center and fit it
+	// around the scene bounding sphere
+	glm::vec3 lightDirection = glm::normalize(sceneCenter - lightPosition);
+	glm::vec3 upDirection = glm::vec3(0.0f, 1.0f, 0.0f);
+	if (fabs(lightDirection.y) > 0.99f)
+	{
+		upDirection = glm::vec3(0.0f, 0.0f, 1.0f);
+	}
+	float lightDistance = glm::length(sceneCenter - lightPosition);
+	float sineHalfFov = sceneRadius / lightDistance;
+	if (sineHalfFov > 0.99f)
+	{
+		sineHalfFov = 0.99f;
+	}
+	float fieldOfView = 2.0f * asin(sineHalfFov);
+	float nearPlane = lightDistance - sceneRadius;
+	if (nearPlane < 0.1f)
+	{
+		nearPlane = 0.1f;
+	}
+	float farPlane = lightDistance + sceneRadius;
+
+	cameraData.view = glm::lookAt(lightPosition, sceneCenter, upDirection);
+	cameraData.projection = glm::perspective(fieldOfView, 1.0f,
+		nearPlane, farPlane);
+	cameraData.viewPosition = glm::vec4(lightPosition, 1.0f);
+
+	// the matrix the fragment shader uses to look the world
+	// position up in the map - clip space remapped to [0,1]
+	glm::mat4 biasMatrix =
+		glm::translate(glm::vec3(0.5f, 0.5f, 0.5f)) *
+		glm::scale(glm::vec3(0.5f, 0.5f, 0.5f));
+	m_shadowMatrices[lightIndex] =
+		biasMatrix * cameraData.projection * cameraData.view;
+
+	// stand the light in for the camera while the map renders,
+	// remembering what was bound so it can be put back
+	glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, g_CameraBlockBinding,
+		&previousCameraUBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_shadowCameraUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(cameraData), &cameraData);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_CameraBlockBinding, m_shadowCameraUBO);
+
+	// render the whole scene depth-only into the light's map
+	// layer - no culling, every object is a potential caster.
+	// the caller may be rendering into an offscreen target
+	// (benchmark mode, the scaled render path), so the bound
+	// framebuffer is saved and restored like the viewport
+	glGetIntegerv(GL_VIEWPORT, previousViewport);
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_shadowFBO);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+		m_shadowMapArray, 0, lightIndex);
+	glViewport(0, 0, g_ShadowMapSize, g_ShadowMapSize);
+	glEnable(GL_DEPTH_TEST);
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_DEPTH_ONLY);
+	m_basicMeshes->BindMeshBuffers();
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		const DRAW_BATCH& batch = m_drawBatches[index];
+		GLuint baseInstance = m_basicMeshes->SetInstanceData(batch.instances);
+		QueueSceneObjectMesh(batch.meshID, (int)batch.instances.size(),
+			baseInstance);
+	}
+	m_basicMeshes->SubmitIndirectFrame();
+
+	// restore the caller's framebuffer and the real camera
+	m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_LIT);
+	glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+	glViewport(previousViewport[0], previousViewport[1],
+		previousViewport[2], previousViewport[3]);
+	glBindBufferBase(GL_UNIFORM_BUFFER, g_CameraBlockBinding,
+		(GLuint)previousCameraUBO);
+}
+
+/***********************************************************
+ *  RenderShadowMaps()
+ *
+ *  This method re-renders any invalidated cached shadow
+ *  maps and uploads the refreshed shadow matrix block.  It
+ *  is called at the start of RenderScene() - for the static
+ *  scene every map renders on the first frame and the call
+ *  is a no-op from then on.
+ ***********************************************************/
+void SceneManager::RenderShadowMaps()
+{
+	bool bAnyRendered = false;
+
+	for (int light = 0; light < m_lightCount; light++)
+	{
+		if (!m_shadowMapDirty[light])
+		{
+			continue;
+		}
+		if (!bAnyRendered)
+		{
+			PrepareShadowResources();
+		}
+		RenderShadowMap(light);
+		m_shadowMapDirty[light] = false;
+		bAnyRendered = true;
+	}
+
+	// refresh the shadow matrix block the fragment shader
+	// samples with
+	if (bAnyRendered)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_shadowMatricesUBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(m_shadowMatrices),
+			m_shadowMatrices);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+}
+
+/***********************************************************
+ *  PrepareOcclusionQueries()
+ *
+ *  This method creates the unit-box proxy mesh and one
+ *  occlusion query object for every batched instance.  It
+ *  is called once from PrepareScene() after the draw
+ *  batches have been built, and only when the occlusion
+ *  culling mode is on.
+ ***********************************************************/
+void SceneManager::PrepareOcclusionQueries()
+{
+	// build the proxy vertex array - positions only on
+	// location 0, the per-proxy model matrix is passed on the
+	// generic vertex attributes the instance buffer normally
+	// feeds, so the depth-only shader variant draws it as-is
+	glGenVertexArrays(1, &m_occlusionVAO);
+	glGenBuffers(1, &m_occlusionVBO);
+	glBindVertexArray(m_occlusionVAO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_occlusionVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(g_OcclusionBoxVertices),
+		g_OcclusionBoxVertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+		3 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// one query per batched instance - every instance starts
+	// out visible until a completed query proves otherwise
+	int totalQueries = 0;
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		DRAW_BATCH& batch = m_drawBatches[index];
+		batch.occlusion.resize(batch.instances.size());
+		for (size_t instance = 0; instance < batch.occlusion.size(); instance++)
+		{
+			glGenQueries(1, &batch.occlusion[instance].queryID);
+			batch.occlusion[instance].bVisible = true;
+			batch.occlusion[instance].bQueryInFlight = false;
+			totalQueries++;
+		}
+	}
+
+	std::cout << "INFO: occlusion culling enabled with "
+		<< totalQueries << " instance queries" << std::endl;
+}
+
+/***********************************************************
+ *  RunOcclusionQueryPass()
+ *
+ *  This method runs the occlusion query pass at the end of
+ *  the frame, after the scene has laid down its final
+ *  depth.  For every instance inside the view frustum it
+ *  collects the result of the query issued a previous
+ *  frame, then draws the instance's bounding-box proxy
+ *  inside a GL_ANY_SAMPLES_PASSED query with all writes
+ *  masked off.  Instances whose proxy rasterized zero
+ *  samples are skipped by the cull loop a frame later.
+ ***********************************************************/
+void SceneManager::RunOcclusionQueryPass()
+{
+	if (0 == m_occlusionVAO)
+	{
+		return;
+	}
+
+	// the proxies are pure depth tests - no color or depth
+	// writes, drawn with the empty depth-only fragment stage
+	m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_DEPTH_ONLY);
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glBindVertexArray(m_occlusionVAO);
+
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		DRAW_BATCH& batch = m_drawBatches[index];
+		for (size_t instance = 0; instance < batch.occlusion.size(); instance++)
+		{
+			OCCLUSION_STATE& occlusion = batch.occlusion[instance];
+			const glm::vec4& bounds = batch.bounds[instance];
+
+			// instances outside the frustum keep their last
+			// result - the frustum test already culls them
+			if (!SphereInFrustum(bounds))
+			{
+				continue;
+			}
+
+			// the near plane can clip away the proxy of an
+			// instance the camera is inside or touching, which
+			// would read as occluded - keep those visible
+			if (glm::length(glm::vec3(bounds) - g_ViewPosition) <
+				(bounds.w + g_OcclusionNearMargin))
+			{
+				occlusion.bVisible = true;
+				continue;
+			}
+
+			// collect the result of the query issued a previous
+			// frame - never wait on one, a result that is not
+			// ready yet is simply picked up on a later frame
+			if (occlusion.bQueryInFlight)
+			{
+				GLuint available = 0;
+				glGetQueryObjectuiv(occlusion.queryID,
+					GL_QUERY_RESULT_AVAILABLE, &available);
+				if (0 == available)
+				{
+					continue;
+				}
+				GLuint samplesPassed = 0;
+				glGetQueryObjectuiv(occlusion.queryID,
+					GL_QUERY_RESULT, &samplesPassed);
+				occlusion.bVisible = (0 != samplesPassed);
+				occlusion.bQueryInFlight = false;
+			}
+
+			// draw the bounding-box proxy against the frame's
+			// depth - the model matrix rides on the generic
+			// vertex attributes of the instance matrix slots
+			glm::mat4 proxyMatrix =
+				glm::translate(glm::vec3(bounds)) *
+				glm::scale(glm::vec3(2.0f * bounds.w));
+			for (int column = 0; column < 4; column++)
+			{
+				glVertexAttrib4fv(3 + column, &proxyMatrix[column][0]);
+			}
+
+			glBeginQuery(GL_ANY_SAMPLES_PASSED, occlusion.queryID);
+			glDrawArrays(GL_TRIANGLES, 0, 36);
+			glEndQuery(GL_ANY_SAMPLES_PASSED);
+			FrameProfiler::CountDrawCall();
+			occlusion.bQueryInFlight = true;
+		}
+	}
+
+	glBindVertexArray(0);
+	glDepthMask(GL_TRUE);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_LIT);
+}
+
+/***********************************************************
+ *  QueueSceneObjectMesh()
+ *
+ *  This method is used for queueing one indirect draw
+ *  command for the basic mesh that is associated with the
+ *  passed in mesh ID.  The tessellation level is only used
+ *  by the curved meshes.
+ ***********************************************************/
+void SceneManager::QueueSceneObjectMesh(
+	MESH_ID meshID, int instanceCount, GLuint baseInstance, ShapeMeshes::MESH_LOD lod)
+{
+	switch (meshID)
+	{
+	case MESH_PLANE:
+		m_basicMeshes->QueuePlaneMesh(instanceCount, baseInstance);
+		break;
+	case MESH_BOX:
+		m_basicMeshes->QueueBoxMesh(instanceCount, baseInstance);
+		break;
+	case MESH_CYLINDER:
+		m_basicMeshes->QueueCylinderMesh(instanceCount, baseInstance, lod);
+		break;
+	case MESH_CONE:
+		m_basicMeshes->QueueConeMesh(instanceCount, baseInstance);
+		break;
+	case MESH_SPHERE:
+		m_basicMeshes->QueueSphereMesh(instanceCount, baseInstance, lod);
+		break;
+	case MESH_PRISM:
+		m_basicMeshes->QueuePrismMesh(instanceCount, baseInstance);
+		break;
+	case MESH_PYRAMID4:
+		m_basicMeshes->QueuePyramid4Mesh(instanceCount, baseInstance);
+		break;
+	case MESH_TAPERED_CYLINDER:
+		m_basicMeshes->QueueTaperedCylinderMesh(instanceCount, baseInstance);
+		break;
+	case MESH_TORUS:
+		m_basicMeshes->QueueTorusMesh(instanceCount, baseInstance, lod);
+		break;
+	}
+}
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by
+ *  replaying the draw batches that were built once in
+ *  PrepareScene().  The surviving draws are sorted
+ *  front-to-back, queued as indirect commands and the whole
+ *  frame is submitted with a single multi-draw-indirect
+ *  call - the per-draw shader state lives in the draw state
+ *  storage buffer, so no uniform calls happen here at all.
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	// re-render any invalidated cached shadow maps first -
+	// for the static scene this renders every map on the
+	// first frame and is a no-op from then on
+	RenderShadowMaps();
+
+	// bind the shared mesh vertex array and rotate the
+	// streaming regions once for the frame
+	m_basicMeshes->BindMeshBuffers();
+
+	m_frameDraws.clear();
+	for (size_t index = 0; index < m_drawBatches.size(); index++)
+	{
+		const DRAW_BATCH& batch = m_drawBatches[index];
+
+		// cull the batch against the view frustum, keeping only
+		// the instances whose bounding spheres intersect it, and
+		// track the closest surviving instance for the LOD
+		// selection and depth sorting below
+		m_visibleInstances.clear();
+		float closestDistance = -1.0f;
+		for (size_t instance = 0; instance < batch.instances.size(); instance++)
+		{
+			if (!SphereInFrustum(batch.bounds[instance]))
+			{
+				continue;
+			}
+			// skip instances whose occlusion query reported zero
+			// visible samples last frame - they sit fully behind
+			// other geometry and would shade nothing
+			if (g_OcclusionCulling && !batch.occlusion[instance].bVisible)
+			{
+				continue;
+			}
+			m_visibleInstances.push_back(batch.instances[instance]);
+
+			glm::vec3 position = glm::vec3(
+				batch.instances[instance].modelMatrix[3]);
+			float distance = glm::length(position - g_ViewPosition);
+			if ((closestDistance < 0.0f) || (distance < closestDistance))
+			{
+				closestDistance = distance;
+			}
+		}
+		if (m_visibleInstances.empty())
+		{
+			continue;
+		}
+
+		// select the tessellation level for the curved meshes
+		// from the closest visible instance - the whole batch
+		// shares one mesh, so the closest instance keeps the
+		// visible silhouettes from degrading
+		ShapeMeshes::MESH_LOD lod = ShapeMeshes::MESH_LOD_HIGH;
+		if (IsLODMesh(batch.meshID))
+		{
+			lod = SelectMeshLOD(closestDistance);
+		}
+
+		// stream the visible instances and record the draw for
+		// the depth sort below
+		FRAME_DRAW frameDraw;
+		frameDraw.distance = closestDistance;
+		frameDraw.meshID = batch.meshID;
+		frameDraw.instanceCount = (int)m_visibleInstances.size();
+		frameDraw.baseInstance = m_basicMeshes->SetInstanceData(m_visibleInstances);
+		frameDraw.lod = lod;
+		m_frameDraws.push_back(frameDraw);
+	}
+
+	// order the frame's draws front-to-back - the scene is
+	// fully opaque, so near objects laying their depth down
+	// first lets early-Z reject the covered fragments before
+	// the four-light shading ever runs on them
+	std::sort(m_frameDraws.begin(), m_frameDraws.end(),
+		[](const FRAME_DRAW& a, const FRAME_DRAW& b)
+		{
+			return(a.distance < b.distance);
+		});
+
+	for (size_t index = 0; index < m_frameDraws.size(); index++)
+	{
+		QueueSceneObjectMesh(m_frameDraws[index].meshID,
+			m_frameDraws[index].instanceCount,
+			m_frameDraws[index].baseInstance,
+			m_frameDraws[index].lod);
+	}
+
+	if (g_DepthPrePass)
+	{
+		// lay the frame's depth down first with the depth-only
+		// shader variant - its fragment stage is empty, so the
+		// pre-pass is pure rasterization.  The color writes stay
+		// masked since a shader without outputs leaves the color
+		// attachment undefined
+		m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_DEPTH_ONLY);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		m_basicMeshes->SubmitIndirectFrame();
+
+		// replay the same queued commands with the lit variant
+		// for the color pass - only the fragments that survived
+		// the pre-pass pay for the full shading
+		m_pShaderManager->SelectVariant(ShaderManager::SHADER_VARIANT_LIT);
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glDepthFunc(GL_LEQUAL);
+		glDepthMask(GL_FALSE);
+		m_basicMeshes->SubmitIndirectFrame();
+		glDepthFunc(GL_LESS);
+		glDepthMask(GL_TRUE);
+	}
+	else
+	{
+		// replay the whole frame with a single driver call
+		m_basicMeshes->SubmitIndirectFrame();
+	}
+
+	// test the bounding-box proxies against the depth the
+	// frame just laid down - the results gate the instance
+	// draws a frame later
+	if (g_OcclusionCulling)
+	{
+		RunOcclusionQueryPass();
+	}
+}
@@ -13,6 +13,7 @@
 #include "ShapeMeshes.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /***********************************************************
@@ -29,12 +30,41 @@ public:
 	// destructor
 	~SceneManager();
 
+	// small integer handles that texture and material tags
+	// are interned into during scene preparation - the hot
+	// path works with these instead of tag strings
+	typedef int TextureHandle;
+	typedef int MaterialHandle;
+	static const TextureHandle InvalidTextureHandle = -1;
+	static const MaterialHandle InvalidMaterialHandle = -1;
+
 	struct TEXTURE_INFO
 	{
 		std::string tag;
 		uint32_t ID;
 	};
 
+	// one texture image decoded from file on a worker thread,
+	// waiting to be uploaded to the GPU on the main thread
+	struct DECODED_TEXTURE
+	{
+		std::string filename;
+		std::string tag;
+		unsigned char* pixels;
+		int width;
+		int height;
+		int colorChannels;
+	};
+
+	// the sub-rectangle of the texture atlas that a packed
+	// texture tag resolves to - folded into the per-object
+	// UV transform when the scene objects are added
+	struct ATLAS_REGION
+	{
+		glm::vec2 uvOffset;
+		glm::vec2 uvScale;
+	};
+
 	struct OBJECT_MATERIAL
 	{
 		float ambientStrength;
@@ -45,61 +75,266 @@ public:
 		std::string tag;
 	};
 
+	// identifiers for the basic 3D shapes that can be drawn
+	enum MESH_ID
+	{
+		MESH_PLANE,
+		MESH_BOX,
+		MESH_CYLINDER,
+		MESH_CONE,
+		MESH_SPHERE,
+		MESH_PRISM,
+		MESH_PYRAMID4,
+		MESH_TAPERED_CYLINDER,
+		MESH_TORUS
+	};
+
+	// one retained draw record for the 3D scene - the model
+	// matrix and the texture/material handles are resolved
+	// once when the scene is prepared so rendering a frame
+	// is reduced to a tight loop over these records
+	struct SCENE_OBJECT
+	{
+		MESH_ID meshID;
+		glm::mat4 modelMatrix;
+		bool bUseTexture;
+		glm::vec4 color;
+		int textureSlot;
+		glm::vec2 uvScale;
+		// UV offset into the texture atlas - zero for objects
+		// whose texture is not packed into the atlas
+		glm::vec2 uvOffset;
+		int materialIndex;
+		// world-space bounding sphere for frustum culling -
+		// xyz is the center, w the radius
+		glm::vec4 bounds;
+	};
+
+	// hardware occlusion query state for one batched instance -
+	// the query tests the instance's bounding-box proxy against
+	// the frame's final depth, and the result gates the real
+	// draw one frame later
+	struct OCCLUSION_STATE
+	{
+		GLuint queryID;
+		bool bVisible;
+		bool bQueryInFlight;
+	};
+
+	// one instanced draw batch - all of the scene objects
+	// that share a mesh and identical shader state, drawn
+	// together with a single instanced draw call.  The sort
+	// key packs the shader state so the batch list can be
+	// ordered to minimize state switches between draws
+	struct DRAW_BATCH
+	{
+		uint32_t sortKey;
+		MESH_ID meshID;
+		bool bUseTexture;
+		glm::vec4 color;
+		int textureSlot;
+		glm::vec2 uvScale;
+		glm::vec2 uvOffset;
+		std::vector<ShapeMeshes::INSTANCE_DATA> instances;
+		// world-space bounding spheres parallel to the
+		// instance list, used by the per-frame cull pass
+		std::vector<glm::vec4> bounds;
+		// per-instance occlusion query state parallel to the
+		// instance list - only filled in when the occlusion
+		// culling mode is on
+		std::vector<OCCLUSION_STATE> occlusion;
+	};
+
+	// one draw surviving the cull pass for the current frame -
+	// collected first so the frame can be sorted front-to-back
+	// by camera distance before the commands are queued
+	struct FRAME_DRAW
+	{
+		float distance;
+		MESH_ID meshID;
+		int instanceCount;
+		GLuint baseInstance;
+		ShapeMeshes::MESH_LOD lod;
+	};
+
 private:
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// pointer to basic shapes object
 	ShapeMeshes* m_basicMeshes;
+
+	// uniform buffer objects holding the light sources and
+	// the material table - uploaded once at scene preparation
+	GLuint m_lightsUBO;
+	GLuint m_materialsUBO;
+	// shader storage buffer holding the per-draw state table
+	// the fragment shader indexes with the draw ID - uploaded
+	// once after the draw batches are built
+	GLuint m_drawStateSSBO;
+
+	// the unit-box proxy mesh the occlusion query pass draws
+	// for each instance's bounding volume - positions only,
+	// the model matrix rides on the generic vertex attributes
+	GLuint m_occlusionVAO;
+	GLuint m_occlusionVBO;
+
+	// cached shadow map resources for the static lights - a
+	// depth array texture with one layer per light, rendered
+	// once and invalidated per light, never per frame
+	GLuint m_shadowFBO;
+	GLuint m_shadowMapArray;
+	// uniform buffers holding the world-to-shadow-map matrices
+	// and the light camera used while rendering a map
+	GLuint m_shadowMatricesUBO;
+	GLuint m_shadowCameraUBO;
+	// the world-to-shadow-map matrix per light
+	glm::mat4 m_shadowMatrices[4];
+	// the light positions captured when the lights are set up -
+	// each one is the eye point of its shadow map render
+	glm::vec3 m_lightPositions[4];
+	int m_lightCount;
+	// per-light invalidation flags - a raised flag re-renders
+	// that light's map at the start of the next frame
+	bool m_shadowMapDirty[4];
+	// bounding sphere around the whole scene - the shadow map
+	// frusta are fitted around it
+	glm::vec4 m_sceneBounds;
+
+	// upload the defined object materials into the material
+	// uniform buffer object - called once after the materials
+	// have been defined
+	void UploadMaterialBuffer();
 	// total number of loaded textures
 	int m_loadedTextures;
 	// loaded textures info
 	TEXTURE_INFO m_textureIDs[16];
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// tag-interning registries mapping texture and material
+	// tags to their handles - filled in once during scene
+	// preparation so tag resolution is a single hash lookup
+	std::unordered_map<std::string, TextureHandle> m_textureRegistry;
+	std::unordered_map<std::string, MaterialHandle> m_materialRegistry;
+	// atlas sub-rectangles for the texture tags that were
+	// packed into the shared atlas texture
+	std::unordered_map<std::string, ATLAS_REGION> m_atlasRegions;
+	// retained draw records for the 3D scene, built once in
+	// PrepareScene() and replayed every frame in RenderScene()
+	std::vector<SCENE_OBJECT> m_sceneObjects;
+	// the scene objects grouped into instanced draw batches
+	// by mesh and shader state, built once in PrepareScene()
+	std::vector<DRAW_BATCH> m_drawBatches;
+	// scratch list of the instances in a batch that survived
+	// the frustum cull - a member so the per-frame cull pass
+	// does not allocate
+	std::vector<ShapeMeshes::INSTANCE_DATA> m_visibleInstances;
+	// scratch list of the frame's surviving draws, sorted
+	// front-to-back before the commands are queued
+	std::vector<FRAME_DRAW> m_frameDraws;
 
 	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
+	bool CreateGLTexture(const char* filename, const std::string& tag);
+	// decode a texture image file into memory - safe to call
+	// from worker threads, does no OpenGL work
+	static bool DecodeTextureImage(DECODED_TEXTURE& decoded);
+	// upload a decoded texture image into an OpenGL texture
+	// through a pixel buffer object - main thread only
+	bool CreateGLTextureFromDecoded(DECODED_TEXTURE& decoded);
+	// load a DDS container with a block-compressed format
+	// (BC1/BC3/BC7) and a pre-baked mip chain - main thread only
+	bool CreateGLTextureFromDDS(const char* filename, const std::string& tag);
+	// pack the small decoded textures into one atlas texture
+	// and record the UV sub-rectangle for each packed tag
+	void BuildTextureAtlas(std::vector<DECODED_TEXTURE>& decodedTextures);
 	// bind loaded OpenGL textures to slots in memory
 	void BindGLTextures();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const std::string& tag);
+	int FindTextureSlot(const std::string& tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material);
+	// find the index of a defined material by tag
+	int FindMaterialIndex(const std::string& tag);
 
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
+	// add one retained draw record into the scene object list
+	void AddSceneObject(
+		MESH_ID meshID,
 		glm::vec3 scaleXYZ,
 		float XrotationDegrees,
 		float YrotationDegrees,
 		float ZrotationDegrees,
-		glm::vec3 positionXYZ);
+		glm::vec3 positionXYZ,
+		glm::vec4 color,
+		const std::string& textureTag,
+		glm::vec2 uvScale,
+		const std::string& materialTag);
+
+	// build the retained scene object list - called once
+	// from PrepareScene()
+	void BuildSceneObjects();
+
+	// load the retained scene object list from the binary
+	// scene file with one bulk read - returns true when a
+	// valid scene file was loaded
+	bool LoadSceneBinary();
+	// write the retained scene object list out as the binary
+	// scene file for the next launch
+	void SaveSceneBinary();
 
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
+	// group the retained scene objects into instanced draw
+	// batches - called once from PrepareScene() after the
+	// scene object list has been built
+	void BuildDrawBatches();
 
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
+	// upload the per-batch shader state into the draw state
+	// storage buffer - called once from PrepareScene() after
+	// the draw batches are built and sorted
+	void UploadDrawStateBuffer();
 
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
+	// create the shadow map array, the framebuffer and the
+	// shadow uniform buffers on first use
+	void PrepareShadowResources();
+	// render one light's cached shadow map - the whole scene
+	// is drawn depth-only from the light's point of view
+	void RenderShadowMap(int lightIndex);
+	// re-render any invalidated shadow maps - called at the
+	// start of RenderScene(), a no-op when every map is clean
+	void RenderShadowMaps();
 
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
+	// create the proxy mesh and the per-instance occlusion
+	// query objects - called once from PrepareScene() when
+	// the occlusion culling mode is on
+	void PrepareOcclusionQueries();
+
+	// collect last frame's occlusion results and issue the
+	// bounding-box proxy queries against the frame's depth -
+	// called at the end of RenderScene()
+	void RunOcclusionQueryPass();
+
+	// queue one indirect draw command for the basic mesh
+	// associated with the passed in mesh ID
+	void QueueSceneObjectMesh(
+		MESH_ID meshID,
+		int instanceCount,
+		GLuint baseInstance,
+		ShapeMeshes::MESH_LOD lod = ShapeMeshes::MESH_LOD_HIGH);
 
 public:
 
-	// The following methods are for the students to 
+	// build the model matrix for an object from the passed
+	// in scale, rotation and position transformation values -
+	// public and static so the benchmark harness can measure
+	// the exact matrix build the scene preparation runs
+	static glm::mat4 BuildModelMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// The following methods are for the students to
 	// customize for their own 3D scene
 	void PrepareScene();
 	void RenderScene();
@@ -109,6 +344,12 @@ public:
 
 	// pre-set light sources for 3D scene
 	void SetupSceneLights();
+
+	// mark one light's cached shadow map for a re-render -
+	// call when that light or a caster in its volume changes.
+	// the static scene never does, so the steady-state cost
+	// of the shadows is a single array texture sample
+	void InvalidateShadowMap(int lightIndex);
 	// pre-define the object materials for lighting
 	void DefineObjectMaterials();
 
@@ -12,9 +12,24 @@
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>    
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 bool g_IsPerspective = true;  // Default to perspective projection
+// internal render scale parsed from the command line - the
+// scene is shaded at this fraction (or multiple) of the
+// window size and upsampled for presentation.  Adjusted at
+// runtime with the bracket keys; the callbacks and the
+// render path both run on the main thread
+extern float g_RenderScale;
+glm::vec3 g_ViewPosition;     // Camera position for the current frame - read
+                              // by the scene manager to select mesh LOD levels
+glm::vec4 g_FrustumPlanes[6]; // View-frustum planes for the current frame -
+                              // read by the scene manager to cull draws
 
 // declaration of the global variables and defines
 namespace
@@ -22,25 +37,108 @@ namespace
 	// Variables for window width and height
 	const int WINDOW_WIDTH = 1000;
 	const int WINDOW_HEIGHT = 800;
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
+
+	// uniform buffer binding point for the camera block in
+	// the shaders - matches the explicit binding layout
+	const GLuint g_CameraBlockBinding = 3;
+
+	// bounds and step for the runtime render scale adjustment
+	const float g_RenderScaleMin = 0.25f;
+	const float g_RenderScaleMax = 2.0f;
+	const float g_RenderScaleStep = 0.05f;
+
+	// std140 mirror of the camera block in the shaders
+	struct CAMERA_DATA
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 viewPosition;
+	};
 
 	// camera object used for viewing and interacting with
-	// the 3D scene
+	// the 3D scene - owned by the update thread, the input
+	// callbacks on the main thread only hand deltas across
 	Camera* g_pCamera = nullptr;
 
 	// these variables are used for mouse movement processing
+	// inside the callback - main thread only
 	float gLastX = WINDOW_WIDTH / 2.0f;
 	float gLastY = WINDOW_HEIGHT / 2.0f;
 	bool gFirstMouse = true;
 
-	// time between current frame and last frame
+	// time between current update tick and the last one -
+	// update thread only
 	float gDeltaTime = 0.0f;
 	float gLastFrame = 0.0f;
 
-	// if orthographic projection is on, this value will be
-	// true
-	bool bOrthographicProjection = false;
+	// held state of the camera movement keys, maintained by
+	// the keyboard callback on the main thread and read by
+	// the update thread
+	std::atomic<bool> g_KeysHeld[GLFW_KEY_LAST + 1];
+	// number of movement keys currently held - zero on idle
+	// ticks, which skips the movement processing entirely
+	std::atomic<int> g_MovementKeysDown(0);
+
+	// mouse movement offsets accumulated by the callback and
+	// drained by the update thread each tick
+	std::atomic<float> g_PendingMouseX(0.0f);
+	std::atomic<float> g_PendingMouseY(0.0f);
+	// scroll wheel steps accumulated by the callback - each
+	// step scales the camera movement speed by ten percent
+	std::atomic<int> g_PendingScrollSteps(0);
+	// projection mode requested by the P/O keys, applied by
+	// the update thread together with the dirty flag below
+	std::atomic<bool> g_PendingPerspective(true);
+
+	// dirty flags set by the input callbacks - the view and
+	// projection matrices are only recomputed and republished
+	// when these are raised.  both start raised so the first
+	// update tick computes and publishes everything
+	std::atomic<bool> g_bViewDirty(true);
+	std::atomic<bool> g_bProjectionDirty(true);
+
+	// accumulate into an atomic float with a compare-exchange
+	// loop - the callbacks can fire between the update ticks
+	// that drain the pending values
+	void AtomicAddFloat(std::atomic<float>& target, float value)
+	{
+		float current = target.load();
+		while (!target.compare_exchange_weak(current, current + value))
+		{
+		}
+	}
+
+	// is the passed in key one of the camera movement keys
+	bool IsMovementKey(int key)
+	{
+		return((key == GLFW_KEY_W) || (key == GLFW_KEY_S) ||
+			(key == GLFW_KEY_A) || (key == GLFW_KEY_D) ||
+			(key == GLFW_KEY_Q) || (key == GLFW_KEY_E));
+	}
+
+	// extract the six view-frustum planes from the combined
+	// view-projection matrix (Gribb/Hartmann).  The planes
+	// are normalized so their distances compare directly
+	// against bounding sphere radii
+	void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4* planes)
+	{
+		glm::vec4 row0 = glm::row(viewProjection, 0);
+		glm::vec4 row1 = glm::row(viewProjection, 1);
+		glm::vec4 row2 = glm::row(viewProjection, 2);
+		glm::vec4 row3 = glm::row(viewProjection, 3);
+
+		planes[0] = row3 + row0;  // left
+		planes[1] = row3 - row0;  // right
+		planes[2] = row3 + row1;  // bottom
+		planes[3] = row3 - row1;  // top
+		planes[4] = row3 + row2;  // near
+		planes[5] = row3 - row2;  // far
+
+		for (int plane = 0; plane < 6; plane++)
+		{
+			planes[plane] /= glm::length(glm::vec3(planes[plane]));
+		}
+	}
 }
 
 /***********************************************************
@@ -54,6 +152,25 @@ ViewManager::ViewManager(
 	// initialize the member variables
 	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_cameraUBO = 0;
+	// hand one frame-state slot to each role - the write and
+	// read slots are thread-private, the ready slot sits in
+	// the atomic exchange between them
+	m_pWriteState = &m_frameStates[0];
+	m_pReadState = &m_frameStates[1];
+	m_pReadyState = &m_frameStates[2];
+	m_bFrameStateFresh = false;
+	m_bUpdateThreadRunning = false;
+	// the scaled scene target is created lazily on the first
+	// frame that actually needs it
+	m_sceneFBO = 0;
+	m_sceneColorBuffer = 0;
+	m_sceneDepthBuffer = 0;
+	m_sceneTargetWidth = 0;
+	m_sceneTargetHeight = 0;
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_bScenePassScaled = false;
 	g_pCamera = new Camera();
 	// default camera view parameters
 	g_pCamera->Position = glm::vec3(0.5f, 5.5f, 10.0f);
@@ -69,9 +186,27 @@ ViewManager::ViewManager(
  ***********************************************************/
 ViewManager::~ViewManager()
 {
+	// make sure the update thread is down before the camera
+	// it owns goes away
+	StopUpdateThread();
+
 	// free up allocated memory
 	m_pShaderManager = NULL;
 	m_pWindow = NULL;
+	if (0 != m_cameraUBO)
+	{
+		glDeleteBuffers(1, &m_cameraUBO);
+		m_cameraUBO = 0;
+	}
+	if (0 != m_sceneFBO)
+	{
+		glDeleteRenderbuffers(1, &m_sceneColorBuffer);
+		glDeleteRenderbuffers(1, &m_sceneDepthBuffer);
+		glDeleteFramebuffers(1, &m_sceneFBO);
+		m_sceneFBO = 0;
+		m_sceneColorBuffer = 0;
+		m_sceneDepthBuffer = 0;
+	}
 	if (NULL != g_pCamera)
 	{
 		delete g_pCamera;
@@ -106,6 +241,10 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
 	//initialize scroll callback
 	glfwSetScrollCallback(window, &ViewManager::Scroll_Callback);
+	// this callback is used to receive keyboard press/release
+	// events - key state is tracked here instead of being
+	// polled every frame
+	glfwSetKeyCallback(window, &ViewManager::Keyboard_Callback);
 
 	// tell GLFW to capture all mouse events
 	//glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
@@ -145,77 +284,134 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 	gLastX = xMousePos;
 	gLastY = yMousePos;
 
-	// move the 3D camera according to the calculated offsets
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+	// hand the offsets across to the update thread - the
+	// camera itself is owned by that thread
+	AtomicAddFloat(g_PendingMouseX, xOffset);
+	AtomicAddFloat(g_PendingMouseY, yOffset);
 }
 
 /***********************************************************
- *  ProcessKeyboardEvents()
+ *  Keyboard_Callback()
  *
- *  This method is called to process any keyboard events
- *  that may be waiting in the event queue.
+ *  This method is automatically called from GLFW whenever
+ *  a key is pressed or released within the active GLFW
+ *  display window.  It tracks the held movement keys and
+ *  handles the one-shot keys, so the per-frame path does
+ *  no key polling at all.
  ***********************************************************/
-void ViewManager::ProcessKeyboardEvents()
+void ViewManager::Keyboard_Callback(GLFWwindow* window, int key, int scancode,
+	int action, int mods)
 {
-	// close the window if the escape key has been pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+	if ((key < 0) || (key > GLFW_KEY_LAST))
 	{
-		glfwSetWindowShouldClose(m_pWindow, true);
+		return;
 	}
 
-	// if the camera object is null, then exit this method
-	if (NULL == g_pCamera)
+	// track the held state of the camera movement keys - the
+	// exchange keeps the held count right even with repeated
+	// press or release events
+	if (IsMovementKey(key))
+	{
+		if ((action == GLFW_PRESS) && !g_KeysHeld[key].exchange(true))
+		{
+			g_MovementKeysDown++;
+		}
+		else if ((action == GLFW_RELEASE) && g_KeysHeld[key].exchange(false))
+		{
+			g_MovementKeysDown--;
+		}
+		return;
+	}
+
+	// the one-shot keys act on the press event only
+	if (action == GLFW_PRESS)
+	{
+		switch (key)
+		{
+		// close the window
+		case GLFW_KEY_ESCAPE:
+			glfwSetWindowShouldClose(window, true);
+			break;
+		// toggle projection mode: P for Perspective, O for
+		// Orthographic - applied on the next update tick
+		case GLFW_KEY_P:
+			g_PendingPerspective = true;
+			g_bProjectionDirty = true;
+			break;
+		case GLFW_KEY_O:
+			g_PendingPerspective = false;
+			g_bProjectionDirty = true;
+			break;
+		// adjust the internal render scale: [ shades fewer
+		// pixels, ] shades more.  The render path picks the
+		// new scale up on the next frame
+		case GLFW_KEY_LEFT_BRACKET:
+			g_RenderScale -= g_RenderScaleStep;
+			if (g_RenderScale < g_RenderScaleMin)
+			{
+				g_RenderScale = g_RenderScaleMin;
+			}
+			std::cout << "INFO: render scale: " << g_RenderScale << std::endl;
+			break;
+		case GLFW_KEY_RIGHT_BRACKET:
+			g_RenderScale += g_RenderScaleStep;
+			if (g_RenderScale > g_RenderScaleMax)
+			{
+				g_RenderScale = g_RenderScaleMax;
+			}
+			std::cout << "INFO: render scale: " << g_RenderScale << std::endl;
+			break;
+		}
+	}
+}
+
+/***********************************************************
+ *  ProcessKeyboardEvents()
+ *
+ *  This method is called to apply the movement keys that
+ *  the keyboard callback tracked as held.  On idle frames -
+ *  the overwhelming majority - it is a single counter check.
+ ***********************************************************/
+void ViewManager::ProcessKeyboardEvents()
+{
+	// nothing held - nothing to do
+	if ((0 == g_MovementKeysDown) || (NULL == g_pCamera))
 	{
 		return;
 	}
 
 	// process camera zooming in and out
-	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_W])
 	{
 		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_S])
 	{
 		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
 	}
 
 	// process camera panning left and right
-	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_A])
 	{
 		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_D])
 	{
 		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
 	}
 
 	// process camera upward and downward movement with Q and E keys
-	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_Q])
 	{
 		g_pCamera->ProcessKeyboard(UP, gDeltaTime);  // Move camera up
 	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
+	if (g_KeysHeld[GLFW_KEY_E])
 	{
 		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);  // Move camera down
 	}
 
-	// Toggle projection mode: P for Perspective, O for Orthographic
-	static bool isPToggled = false;  // To prevent repeated toggles while holding the key
-	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS && !isPToggled)
-	{
-		g_IsPerspective = true; // Set to perspective mode
-		isPToggled = true;
-	}
-	else if (glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_PRESS && !isPToggled)
-	{
-		g_IsPerspective = false; // Set to orthographic mode
-		isPToggled = true;
-	}
-	else if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_RELEASE &&
-		glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_RELEASE)
-	{
-		isPToggled = false;  // Reset toggle flag when keys are released
-	}
+	// the camera moved - recompute the view matrix this frame
+	g_bViewDirty = true;
 }
 
 
@@ -227,18 +423,57 @@ void ViewManager::ProcessKeyboardEvents()
  ***********************************************************/
 void ViewManager::Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset)
 {
-	// Adjust the camera's movement speed based on scroll wheel
-	if (g_pCamera)
+	// hand the scroll steps across to the update thread -
+	// each step adjusts the camera movement speed by 10%
+	if (yOffset > 0)
 	{
-		// If scrolling up, increase speed by 10%
-		if (yOffset > 0)
+		g_PendingScrollSteps++;
+	}
+	else if (yOffset < 0)
+	{
+		g_PendingScrollSteps--;
+	}
+}
+
+/***********************************************************
+ *  UpdateSceneView()
+ *
+ *  This method is used for applying the pending input the
+ *  callbacks handed across, recomputing the camera state and
+ *  publishing a new frame-state snapshot.  It runs on the
+ *  update thread, which owns the camera exclusively.
+ ***********************************************************/
+void ViewManager::UpdateSceneView()
+{
+	// per-tick timing
+	float currentFrame = glfwGetTime();
+	gDeltaTime = currentFrame - gLastFrame;
+	gLastFrame = currentFrame;
+
+	// drain the mouse offsets the callback accumulated and
+	// move the 3D camera accordingly
+	float mouseX = g_PendingMouseX.exchange(0.0f);
+	float mouseY = g_PendingMouseY.exchange(0.0f);
+	if ((mouseX != 0.0f) || (mouseY != 0.0f))
+	{
+		g_pCamera->ProcessMouseMovement(mouseX, mouseY);
+		g_bViewDirty = true;
+	}
+
+	// drain the scroll steps - each one adjusts the camera
+	// movement speed by 10%
+	int scrollSteps = g_PendingScrollSteps.exchange(0);
+	if (0 != scrollSteps)
+	{
+		while (scrollSteps > 0)
 		{
 			g_pCamera->MovementSpeed *= 1.1f;
+			scrollSteps--;
 		}
-		// If scrolling down, decrease speed by 10%
-		else if (yOffset < 0)
+		while (scrollSteps < 0)
 		{
 			g_pCamera->MovementSpeed *= 0.9f;
+			scrollSteps++;
 		}
 
 		// limit the movement speed to a reasonable range (e.g., between 0.1 and 10)
@@ -247,57 +482,272 @@ void ViewManager::Scroll_Callback(GLFWwindow* window, double xOffset, double yOf
 		if (g_pCamera->MovementSpeed > 10.0f)
 			g_pCamera->MovementSpeed = 10.0f;
 	}
+
+	// apply any movement keys the keyboard callback tracked
+	// as held - raises the view dirty flag when the camera
+	// actually moved
+	ProcessKeyboardEvents();
+
+	// recompute the view matrix only when the camera moved
+	bool bViewChanged = g_bViewDirty.exchange(false);
+	if (bViewChanged)
+	{
+		m_view = g_pCamera->GetViewMatrix();
+	}
+
+	// recompute the projection matrix only when the
+	// perspective/orthographic mode was toggled
+	bool bProjectionChanged = g_bProjectionDirty.exchange(false);
+	if (bProjectionChanged)
+	{
+		g_IsPerspective = g_PendingPerspective;
+		if (g_IsPerspective)
+		{
+			// Perspective projection
+			m_projection = glm::perspective(glm::radians(g_pCamera->Zoom),
+				(GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT,
+				0.1f, 100.0f);
+		}
+		else
+		{
+			// Orthographic projection
+			float orthoScale = 10.0f; // Adjust based on your scene size
+			float aspectRatio = (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT;
+			m_projection = glm::ortho(-orthoScale * aspectRatio, orthoScale * aspectRatio,
+				-orthoScale, orthoScale,
+				0.1f, 100.0f);
+		}
+	}
+
+	// nothing changed - the published snapshot stays current
+	// and idle ticks cost almost nothing
+	if (!bViewChanged && !bProjectionChanged)
+	{
+		return;
+	}
+
+	// fill the write slot with the new immutable snapshot
+	m_pWriteState->view = m_view;
+	m_pWriteState->projection = m_projection;
+	m_pWriteState->viewPosition = glm::vec4(g_pCamera->Position, 1.0f);
+	ExtractFrustumPlanes(m_projection * m_view, m_pWriteState->frustumPlanes);
+
+	// publish it with a lock-free pointer exchange - the slot
+	// that was waiting in the ready seat comes back as the
+	// next write slot, so neither thread ever blocks
+	m_pWriteState = m_pReadyState.exchange(m_pWriteState);
+	m_bFrameStateFresh = true;
+}
+
+/***********************************************************
+ *  UpdateLoop()
+ *
+ *  The entry loop for the camera update thread.
+ ***********************************************************/
+void ViewManager::UpdateLoop()
+{
+	while (m_bUpdateThreadRunning)
+	{
+		UpdateSceneView();
+
+		// yield between the update ticks - camera math at this
+		// rate leaves the core free for future animation work
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+/***********************************************************
+ *  StartUpdateThread()
+ *
+ *  This method is used for starting the camera update
+ *  thread.  The first snapshot is produced synchronously so
+ *  the render thread never runs without one.
+ ***********************************************************/
+void ViewManager::StartUpdateThread()
+{
+	if (m_bUpdateThreadRunning)
+	{
+		return;
+	}
+
+	// the dirty flags start raised, so this first tick always
+	// publishes a complete snapshot
+	UpdateSceneView();
+
+	m_bUpdateThreadRunning = true;
+	m_updateThread = std::thread(&ViewManager::UpdateLoop, this);
+}
+
+/***********************************************************
+ *  StopUpdateThread()
+ *
+ *  This method is used for stopping the camera update
+ *  thread and waiting for it to finish.
+ ***********************************************************/
+void ViewManager::StopUpdateThread()
+{
+	m_bUpdateThreadRunning = false;
+	if (m_updateThread.joinable())
+	{
+		m_updateThread.join();
+	}
 }
 
 /***********************************************************
  *  PrepareSceneView()
  *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene
- *  rendering
+ *  This method is used for preparing the 3D scene rendering
+ *  on the render thread - it consumes the latest frame-state
+ *  snapshot the update thread published and uploads the
+ *  camera state only when it changed.
  ***********************************************************/
 void ViewManager::PrepareSceneView()
 {
-	glm::mat4 view;
-	glm::mat4 projection;
+	// create the camera uniform buffer on the first frame -
+	// there was no GL context yet during construction - and
+	// attach it to the camera block binding point shared by
+	// every shader program variant
+	if (0 == m_cameraUBO)
+	{
+		glGenBuffers(1, &m_cameraUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(CAMERA_DATA), NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, g_CameraBlockBinding, m_cameraUBO);
+	}
 
-	// per-frame timing
-	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
+	// nothing published since the last frame - the camera
+	// buffer and the culling state are still current, idle
+	// frames upload nothing at all
+	if (!m_bFrameStateFresh.exchange(false))
+	{
+		return;
+	}
 
-	// process any keyboard events that may be waiting in the event queue
-	ProcessKeyboardEvents();
+	// swap the read slot against the freshly published one -
+	// the snapshot is immutable once it leaves the update
+	// thread, so it can be read without any further locking
+	m_pReadState = m_pReadyState.exchange(m_pReadState);
+
+	// upload the camera block in one piece
+	CAMERA_DATA cameraData;
+	cameraData.view = m_pReadState->view;
+	cameraData.projection = m_pReadState->projection;
+	cameraData.viewPosition = m_pReadState->viewPosition;
+	glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CAMERA_DATA), &cameraData);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// publish the camera position and the frustum planes for
+	// the LOD selection and cull pass in the scene manager
+	// render path
+	g_ViewPosition = glm::vec3(m_pReadState->viewPosition);
+	for (int plane = 0; plane < 6; plane++)
+	{
+		g_FrustumPlanes[plane] = m_pReadState->frustumPlanes[plane];
+	}
+}
+
+/***********************************************************
+ *  BeginSceneRender()
+ *
+ *  This method binds the scene render target for the frame.
+ *  When the render scale is 1.0 the scene is rendered
+ *  straight into the window framebuffer as before - with
+ *  any other scale it is rendered into an offscreen buffer
+ *  at the scaled size, so every fragment-bound pass only
+ *  shades the scaled pixel count.
+ ***********************************************************/
+void ViewManager::BeginSceneRender()
+{
+	int targetWidth = 0;
+	int targetHeight = 0;
 
-	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
+	// cache the window framebuffer size for the present blit
+	glfwGetFramebufferSize(m_pWindow, &m_windowWidth, &m_windowHeight);
 
-	// define the current projection matrix based on the selected mode
-	if (g_IsPerspective) // g_IsPerspective is a global or class-level boolean flag
+	// the scaled target size - never let it collapse to zero
+	targetWidth = (int)((float)m_windowWidth * g_RenderScale);
+	targetHeight = (int)((float)m_windowHeight * g_RenderScale);
+	if (targetWidth < 1)
 	{
-		// Perspective projection
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom),
-			(GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT,
-			0.1f, 100.0f);
+		targetWidth = 1;
 	}
-	else
+	if (targetHeight < 1)
 	{
-		// Orthographic projection
-		float orthoScale = 10.0f; // Adjust based on your scene size
-		float aspectRatio = (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT;
-		projection = glm::ortho(-orthoScale * aspectRatio, orthoScale * aspectRatio,
-			-orthoScale, orthoScale,
-			0.1f, 100.0f);
+		targetHeight = 1;
 	}
 
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
+	// at native size skip the offscreen target entirely and
+	// render into the window framebuffer
+	if ((targetWidth == m_windowWidth) && (targetHeight == m_windowHeight))
 	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the projection matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		m_bScenePassScaled = false;
+		return;
+	}
+
+	// (re)create the offscreen target when the scaled size
+	// changed - the scale can be adjusted at runtime with the
+	// bracket keys
+	if ((0 == m_sceneFBO) ||
+		(targetWidth != m_sceneTargetWidth) ||
+		(targetHeight != m_sceneTargetHeight))
+	{
+		if (0 == m_sceneFBO)
+		{
+			glGenFramebuffers(1, &m_sceneFBO);
+			glGenRenderbuffers(1, &m_sceneColorBuffer);
+			glGenRenderbuffers(1, &m_sceneDepthBuffer);
+		}
+
+		glBindRenderbuffer(GL_RENDERBUFFER, m_sceneColorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8,
+			targetWidth, targetHeight);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_sceneDepthBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+			targetWidth, targetHeight);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_RENDERBUFFER, m_sceneColorBuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+			GL_RENDERBUFFER, m_sceneDepthBuffer);
+
+		m_sceneTargetWidth = targetWidth;
+		m_sceneTargetHeight = targetHeight;
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
+	glViewport(0, 0, m_sceneTargetWidth, m_sceneTargetHeight);
+	m_bScenePassScaled = true;
+}
+
+/***********************************************************
+ *  PresentSceneRender()
+ *
+ *  This method presents the scaled scene target by blitting
+ *  it to the window framebuffer with linear filtering.  It
+ *  does nothing when the frame was rendered at native size.
+ ***********************************************************/
+void ViewManager::PresentSceneRender()
+{
+	if (!m_bScenePassScaled)
+	{
+		return;
 	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_sceneFBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(
+		0, 0, m_sceneTargetWidth, m_sceneTargetHeight,
+		0, 0, m_windowWidth, m_windowHeight,
+		GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+	// leave the window framebuffer bound at its native
+	// viewport for the buffer swap
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, m_windowWidth, m_windowHeight);
 }
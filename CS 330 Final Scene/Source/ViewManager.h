@@ -13,7 +13,10 @@
 #include "camera.h"
 
 // GLFW library
-#include "GLFW/glfw3.h" 
+#include "GLFW/glfw3.h"
+
+#include <atomic>
+#include <thread>
 
 extern bool g_IsPerspective;
 
@@ -32,20 +35,96 @@ public:
 	// scroll callback for adjusting movement speed
 	static void Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset);
 
+	// keyboard callback for tracking held keys and toggling
+	// the projection mode - keeps the per-frame path free of
+	// key polling
+	static void Keyboard_Callback(GLFWwindow* window, int key, int scancode,
+		int action, int mods);
 
 private:
+	// one immutable snapshot of the per-frame camera state,
+	// produced by the update thread and consumed by the render
+	// thread - neither thread ever touches a slot the other
+	// one owns
+	struct FRAME_STATE
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 viewPosition;
+		glm::vec4 frustumPlanes[6];
+	};
+
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
 
+	// uniform buffer holding the per-frame camera state -
+	// every shader program variant reads this one buffer, so
+	// switching variants mid-frame uploads nothing.  Created
+	// on the first frame since no GL context exists when this
+	// class is constructed
+	GLuint m_cameraUBO;
+
+	// cached view and projection matrices - owned by the
+	// update thread, recomputed only when the camera state
+	// actually changed
+	glm::mat4 m_view;
+	glm::mat4 m_projection;
+
+	// triple-buffered frame-state slots - the update thread
+	// fills its write slot and publishes it with a lock-free
+	// pointer exchange, the render thread swaps its read slot
+	// against the ready slot when a fresh snapshot is waiting
+	FRAME_STATE m_frameStates[3];
+	FRAME_STATE* m_pWriteState;
+	FRAME_STATE* m_pReadState;
+	std::atomic<FRAME_STATE*> m_pReadyState;
+	std::atomic<bool> m_bFrameStateFresh;
+
+	// the camera update thread and its run flag
+	std::thread m_updateThread;
+	std::atomic<bool> m_bUpdateThreadRunning;
+
+	// offscreen scene render target used when the render scale
+	// is not 1.0 - the scene is shaded at the scaled size and
+	// blitted up (or down) to the window for presentation
+	GLuint m_sceneFBO;
+	GLuint m_sceneColorBuffer;
+	GLuint m_sceneDepthBuffer;
+	int m_sceneTargetWidth;
+	int m_sceneTargetHeight;
+	// the window framebuffer size cached at BeginSceneRender()
+	int m_windowWidth;
+	int m_windowHeight;
+	// was the current frame rendered into the scaled target
+	bool m_bScenePassScaled;
+
 	// process keyboard events for interaction with the 3D scene
 	void ProcessKeyboardEvents();
 
+	// apply the pending input, recompute the camera state and
+	// publish a new frame-state snapshot - update thread only
+	void UpdateSceneView();
+	// the update thread entry loop
+	void UpdateLoop();
+
 public:
 	// create the initial OpenGL display window
 	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
-	
+
+	// start and stop the camera update thread - the render
+	// loop only consumes the snapshots it publishes
+	void StartUpdateThread();
+	void StopUpdateThread();
+
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+
+	// bind the scene render target for the frame - an offscreen
+	// buffer at the configured render scale, or the window
+	// framebuffer directly when the scale is 1.0
+	void BeginSceneRender();
+	// upsample the scaled scene target to the window framebuffer
+	void PresentSceneRender();
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.cpp
+// ============
+// control the presentation cadence of the render loop - vsync mode,
+// optional FPS cap and missed-vsync detection
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+#include "FrameProfiler.h"
+
+#include "GLFW/glfw3.h"
+
+#include <iostream>
+#include <thread>
+
+// Namespace for declaring global variables
+namespace
+{
+	// a frame while vsync is on counts as a missed vsync when
+	// it overruns the refresh period by more than half of one -
+	// the margin keeps timer noise from registering as misses
+	const double g_MissedVsyncFactor = 1.5;
+
+	// the final stretch before the FPS cap target is spun
+	// instead of slept - OS sleeps can overshoot by a full
+	// scheduler quantum
+	const std::chrono::milliseconds g_SpinWindow(2);
+}
+
+/***********************************************************
+ *  FramePacer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FramePacer::FramePacer()
+{
+	m_vsyncMode = VSYNC_MODE_ON;
+	m_targetFrameSeconds = 0.0;
+	m_refreshPeriodSeconds = 0.0;
+	m_bInitialized = false;
+}
+
+/***********************************************************
+ *  ~FramePacer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FramePacer::~FramePacer()
+{
+	m_bInitialized = false;
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for applying the configured vsync
+ *  mode through the swap interval and setting up the FPS
+ *  cap.  It must be called once after the OpenGL context
+ *  has been made current.
+ ***********************************************************/
+void FramePacer::Initialize(VSYNC_MODE vsyncMode, int fpsCap)
+{
+	m_vsyncMode = vsyncMode;
+
+	// set the swap interval explicitly - never leave the
+	// presentation cadence to driver defaults
+	switch (m_vsyncMode)
+	{
+	case VSYNC_MODE_OFF:
+		glfwSwapInterval(0);
+		break;
+	case VSYNC_MODE_ADAPTIVE:
+		// a negative interval needs the late-tearing extension -
+		// fall back to standard vsync where it is missing
+		if (glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+			glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+		{
+			glfwSwapInterval(-1);
+		}
+		else
+		{
+			std::cout << "INFO: Adaptive vsync not supported by the driver - "
+				<< "using standard vsync" << std::endl;
+			m_vsyncMode = VSYNC_MODE_ON;
+			glfwSwapInterval(1);
+		}
+		break;
+	case VSYNC_MODE_ON:
+	default:
+		glfwSwapInterval(1);
+		break;
+	}
+
+	// the FPS cap as a target frame duration - zero stays
+	// uncapped
+	m_targetFrameSeconds = 0.0;
+	if (fpsCap > 0)
+	{
+		m_targetFrameSeconds = 1.0 / (double)fpsCap;
+	}
+
+	// query the display refresh period for the missed-vsync
+	// detection
+	m_refreshPeriodSeconds = 0.0;
+	GLFWmonitor* pMonitor = glfwGetPrimaryMonitor();
+	if (NULL != pMonitor)
+	{
+		const GLFWvidmode* pVideoMode = glfwGetVideoMode(pMonitor);
+		if ((NULL != pVideoMode) && (pVideoMode->refreshRate > 0))
+		{
+			m_refreshPeriodSeconds = 1.0 / (double)pVideoMode->refreshRate;
+		}
+	}
+
+	m_lastFrameTime = std::chrono::steady_clock::now();
+	m_bInitialized = true;
+}
+
+/***********************************************************
+ *  Pace()
+ *
+ *  This method is called after the buffer swap each frame.
+ *  It counts the frames that overran the display refresh
+ *  period while vsync was on, then holds the frame to the
+ *  FPS cap target - sleeping for the bulk of the wait so an
+ *  idle scene does not burn a core, spinning only the last
+ *  couple of milliseconds for precision.
+ ***********************************************************/
+void FramePacer::Pace()
+{
+	if (!m_bInitialized)
+	{
+		return;
+	}
+
+	// missed-vsync detection - a frame that took more than
+	// one and a half refresh periods stalled past its blank
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if ((m_vsyncMode != VSYNC_MODE_OFF) && (m_refreshPeriodSeconds > 0.0))
+	{
+		double frameSeconds = std::chrono::duration<double>(
+			now - m_lastFrameTime).count();
+		if (frameSeconds > (m_refreshPeriodSeconds * g_MissedVsyncFactor))
+		{
+			FrameProfiler::CountMissedVsync();
+		}
+	}
+
+	// hold the frame to the FPS cap target
+	if (m_targetFrameSeconds > 0.0)
+	{
+		std::chrono::steady_clock::time_point targetTime = m_lastFrameTime +
+			std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+				std::chrono::duration<double>(m_targetFrameSeconds));
+
+		// sleep until just short of the target, handing the
+		// core back to the OS for the bulk of the wait
+		now = std::chrono::steady_clock::now();
+		while ((targetTime - now) > g_SpinWindow)
+		{
+			std::this_thread::sleep_for((targetTime - now) - g_SpinWindow);
+			now = std::chrono::steady_clock::now();
+		}
+
+		// spin out the final stretch for precision
+		while (std::chrono::steady_clock::now() < targetTime)
+		{
+		}
+	}
+
+	m_lastFrameTime = std::chrono::steady_clock::now();
+}
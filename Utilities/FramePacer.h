@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.h
+// ============
+// control the presentation cadence of the render loop - vsync mode,
+// optional FPS cap and missed-vsync detection
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+
+/***********************************************************
+ *  FramePacer
+ *
+ *  This class contains the code for pacing the main render
+ *  loop.  The swap interval is set explicitly instead of
+ *  being left to driver defaults - off, on, or adaptive
+ *  where the driver supports late tearing.  An optional FPS
+ *  cap holds each frame to a target duration with a sleep
+ *  that hands the core back to the OS, finished by a short
+ *  precise spin.  Frames that overrun the display refresh
+ *  period while vsync is on are counted as missed vsyncs
+ *  through the frame instrumentation surface.
+ ***********************************************************/
+class FramePacer
+{
+public:
+	// constructor
+	FramePacer();
+	// destructor
+	~FramePacer();
+
+	// the supported vertical sync configurations
+	enum VSYNC_MODE
+	{
+		// never wait on the display - uncapped frame rate
+		VSYNC_MODE_OFF,
+		// wait for the vertical blank every frame
+		VSYNC_MODE_ON,
+		// wait for the vertical blank, but tear instead of
+		// stalling when a frame arrives late - falls back to
+		// standard vsync when the driver lacks the extension
+		VSYNC_MODE_ADAPTIVE
+	};
+
+	// apply the vsync mode and the FPS cap - must be called
+	// once after the OpenGL context has been made current.
+	// An fpsCap of zero leaves the frame rate uncapped
+	void Initialize(VSYNC_MODE vsyncMode, int fpsCap);
+
+	// called after the buffer swap each frame - detects the
+	// missed vsyncs and holds the frame to the FPS cap
+	void Pace();
+
+private:
+	// the configured vsync mode
+	VSYNC_MODE m_vsyncMode;
+	// the FPS cap as a frame duration - zero when uncapped
+	double m_targetFrameSeconds;
+	// the display refresh period used for the missed-vsync
+	// detection - zero when it could not be queried
+	double m_refreshPeriodSeconds;
+	// timestamp of the previous Pace() call
+	std::chrono::steady_clock::time_point m_lastFrameTime;
+	// has Initialize() been called
+	bool m_bInitialized;
+};
@@ -0,0 +1,320 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// measure per-frame CPU and GPU timings along with render path counters
+// and periodically dump the collected statistics to the console
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+// render path counters for the current frame
+int FrameProfiler::s_drawCalls = 0;
+int FrameProfiler::s_uniformUploads = 0;
+int FrameProfiler::s_elidedUniforms = 0;
+std::atomic<int> FrameProfiler::s_heapAllocations(0);
+int FrameProfiler::s_missedVsyncs = 0;
+
+// ------------------------------------------------------------------------
+// replaced global allocation operators - every heap allocation anywhere
+// in the application bumps the frame allocation counter, which is how
+// the "zero allocations on the steady-state frame" claim stays verified
+// instead of aspirational.  The operators otherwise behave as standard
+// ------------------------------------------------------------------------
+void* operator new(std::size_t size)
+{
+	FrameProfiler::CountHeapAllocation();
+	void* pointer = malloc(size);
+	if (NULL == pointer)
+	{
+		throw std::bad_alloc();
+	}
+	return(pointer);
+}
+
+void* operator new[](std::size_t size)
+{
+	FrameProfiler::CountHeapAllocation();
+	void* pointer = malloc(size);
+	if (NULL == pointer)
+	{
+		throw std::bad_alloc();
+	}
+	return(pointer);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t size) noexcept
+{
+	free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t size) noexcept
+{
+	free(pointer);
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	memset(m_gpuQueries, 0, sizeof(m_gpuQueries));
+	memset(m_queryIssued, 0, sizeof(m_queryIssued));
+	memset(m_frameHistory, 0, sizeof(m_frameHistory));
+	m_frameParity = 0;
+	m_bInitialized = false;
+	m_frameCount = 0;
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	// free the timer query objects
+	if (m_bInitialized)
+	{
+		glDeleteQueries(TOTAL_GPU_SCOPES * 2, &m_gpuQueries[0][0]);
+		m_bInitialized = false;
+	}
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used for creating the timer query
+ *  objects.  It must be called once after the OpenGL
+ *  context has been initialized.
+ ***********************************************************/
+void FrameProfiler::Initialize()
+{
+	if (!m_bInitialized)
+	{
+		glGenQueries(TOTAL_GPU_SCOPES * 2, &m_gpuQueries[0][0]);
+		m_bInitialized = true;
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is called at the top of the render loop to
+ *  take the CPU frame timestamp and reset the render path
+ *  counters.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	m_frameStartTime = std::chrono::steady_clock::now();
+	s_drawCalls = 0;
+	s_uniformUploads = 0;
+	s_elidedUniforms = 0;
+	s_heapAllocations = 0;
+	// the missed-vsync counter is not reset here - the pacer
+	// counts misses after EndFrame() has run, so the counter
+	// is captured and cleared there instead of being wiped
+	// before the capture ever sees it
+}
+
+/***********************************************************
+ *  BeginGPUScope()
+ *
+ *  This method is used for starting the GL_TIME_ELAPSED
+ *  timer query for the passed in GPU scope.
+ ***********************************************************/
+void FrameProfiler::BeginGPUScope(GPU_SCOPE scope)
+{
+	if (m_bInitialized)
+	{
+		glBeginQuery(GL_TIME_ELAPSED, m_gpuQueries[scope][m_frameParity]);
+	}
+}
+
+/***********************************************************
+ *  EndGPUScope()
+ *
+ *  This method is used for ending the GL_TIME_ELAPSED
+ *  timer query for the passed in GPU scope.
+ ***********************************************************/
+void FrameProfiler::EndGPUScope(GPU_SCOPE scope)
+{
+	if (m_bInitialized)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_queryIssued[scope][m_frameParity] = true;
+	}
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is called after the buffer swap.  It reads
+ *  back the timer queries that were issued the previous
+ *  frame - the one frame of latency is what keeps the
+ *  readback from stalling the pipeline - and captures the
+ *  frame statistics into the history ring.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	FRAME_STATS stats;
+	int readParity = 0;
+
+	// CPU time for the whole frame including the swap
+	std::chrono::steady_clock::time_point frameEndTime =
+		std::chrono::steady_clock::now();
+	stats.cpuFrameMs = std::chrono::duration<double, std::milli>(
+		frameEndTime - m_frameStartTime).count();
+
+	// read the queries issued the previous frame - their
+	// results have had a full frame to become available
+	readParity = m_frameParity ^ 1;
+	for (int scope = 0; scope < TOTAL_GPU_SCOPES; scope++)
+	{
+		stats.gpuScopeMs[scope] = 0.0;
+		if (m_bInitialized && m_queryIssued[scope][readParity])
+		{
+			GLuint64 elapsedNanoseconds = 0;
+			glGetQueryObjectui64v(m_gpuQueries[scope][readParity],
+				GL_QUERY_RESULT, &elapsedNanoseconds);
+			stats.gpuScopeMs[scope] = (double)elapsedNanoseconds / 1000000.0;
+			m_queryIssued[scope][readParity] = false;
+		}
+	}
+
+	stats.drawCalls = s_drawCalls;
+	stats.uniformUploads = s_uniformUploads;
+	stats.elidedUniforms = s_elidedUniforms;
+	stats.heapAllocations = s_heapAllocations;
+	// capture and clear the missed-vsync counter - the pacer
+	// runs after EndFrame(), so a miss it records lands in the
+	// following frame's stats rather than being lost
+	stats.missedVsyncs = s_missedVsyncs;
+	s_missedVsyncs = 0;
+
+	// capture the frame into the history ring
+	m_frameHistory[m_frameCount % FrameHistorySize] = stats;
+	m_frameCount++;
+	m_frameParity ^= 1;
+
+	// periodically dump the averaged statistics
+	if ((m_frameCount % FrameHistorySize) == 0)
+	{
+		DumpStats();
+	}
+}
+
+/***********************************************************
+ *  CountDrawCall()
+ *
+ *  This method is called on the render path each time a
+ *  draw call is submitted.
+ ***********************************************************/
+void FrameProfiler::CountDrawCall()
+{
+	s_drawCalls++;
+}
+
+/***********************************************************
+ *  CountUniformUpload()
+ *
+ *  This method is called on the render path each time a
+ *  uniform value is uploaded to the shader program.
+ ***********************************************************/
+void FrameProfiler::CountUniformUpload()
+{
+	s_uniformUploads++;
+}
+
+/***********************************************************
+ *  CountElidedUniform()
+ *
+ *  This method is called on the render path each time a
+ *  uniform write is dropped because the value matched the
+ *  shadow copy of the last written value.
+ ***********************************************************/
+void FrameProfiler::CountElidedUniform()
+{
+	s_elidedUniforms++;
+}
+
+/***********************************************************
+ *  CountHeapAllocation()
+ *
+ *  This method is called by the replaced global allocation
+ *  operators for every heap allocation on any thread.
+ ***********************************************************/
+void FrameProfiler::CountHeapAllocation()
+{
+	s_heapAllocations++;
+}
+
+/***********************************************************
+ *  CountMissedVsync()
+ *
+ *  This method is called by the frame pacer each time a
+ *  frame overran the display refresh period while vsync
+ *  was on.
+ ***********************************************************/
+void FrameProfiler::CountMissedVsync()
+{
+	s_missedVsyncs++;
+}
+
+/***********************************************************
+ *  DumpStats()
+ *
+ *  This method averages the history ring and prints the
+ *  collected frame statistics to the console.
+ ***********************************************************/
+void FrameProfiler::DumpStats()
+{
+	double totalCpuMs = 0.0;
+	double totalGpuMs[TOTAL_GPU_SCOPES] = { 0.0 };
+	double totalDrawCalls = 0.0;
+	double totalUniformUploads = 0.0;
+	double totalElidedUniforms = 0.0;
+	double totalHeapAllocations = 0.0;
+	double totalMissedVsyncs = 0.0;
+
+	for (int i = 0; i < FrameHistorySize; i++)
+	{
+		totalCpuMs += m_frameHistory[i].cpuFrameMs;
+		for (int scope = 0; scope < TOTAL_GPU_SCOPES; scope++)
+		{
+			totalGpuMs[scope] += m_frameHistory[i].gpuScopeMs[scope];
+		}
+		totalDrawCalls += m_frameHistory[i].drawCalls;
+		totalUniformUploads += m_frameHistory[i].uniformUploads;
+		totalElidedUniforms += m_frameHistory[i].elidedUniforms;
+		totalHeapAllocations += m_frameHistory[i].heapAllocations;
+		totalMissedVsyncs += m_frameHistory[i].missedVsyncs;
+	}
+
+	std::cout << "INFO: frame stats over last " << FrameHistorySize << " frames -"
+		<< " cpu:" << (totalCpuMs / FrameHistorySize) << "ms"
+		<< " gpu view:" << (totalGpuMs[GPU_SCOPE_VIEW] / FrameHistorySize) << "ms"
+		<< " gpu scene:" << (totalGpuMs[GPU_SCOPE_SCENE] / FrameHistorySize) << "ms"
+		<< " draws:" << (totalDrawCalls / FrameHistorySize)
+		<< " uniforms:" << (totalUniformUploads / FrameHistorySize)
+		<< " elided:" << (totalElidedUniforms / FrameHistorySize)
+		<< " allocs:" << (totalHeapAllocations / FrameHistorySize)
+		<< " vsync misses:" << totalMissedVsyncs
+		<< std::endl;
+}
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// measure per-frame CPU and GPU timings along with render path counters
+// and periodically dump the collected statistics to the console
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <chrono>
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class contains the code for instrumenting the main
+ *  render loop.  GPU workloads are bracketed with double
+ *  buffered GL_TIME_ELAPSED timer queries so reading the
+ *  results never stalls the pipeline, CPU frame times are
+ *  measured with the steady clock, and the managers on the
+ *  render path increment counters for draw calls and
+ *  uniform uploads.  The last FrameHistorySize frames are
+ *  kept in a ring buffer and averaged into a periodic
+ *  console stats dump.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// constructor
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// the GPU workloads that are bracketed with timer
+	// queries - the scopes run sequentially, they cannot nest
+	enum GPU_SCOPE
+	{
+		GPU_SCOPE_VIEW,
+		GPU_SCOPE_SCENE,
+		TOTAL_GPU_SCOPES
+	};
+
+	// the statistics captured for one rendered frame
+	struct FRAME_STATS
+	{
+		double cpuFrameMs;
+		double gpuScopeMs[TOTAL_GPU_SCOPES];
+		int drawCalls;
+		int uniformUploads;
+		int elidedUniforms;
+		int heapAllocations;
+		int missedVsyncs;
+	};
+
+	// number of frames kept in the history ring buffer -
+	// also the interval between console stats dumps
+	static const int FrameHistorySize = 120;
+
+	// create the timer query objects - must be called once
+	// after the OpenGL context has been initialized
+	void Initialize();
+
+	// called at the top of the render loop
+	void BeginFrame();
+	// called after the buffer swap - collects the timings
+	// and counters for the frame into the history ring
+	void EndFrame();
+
+	// bracket one GPU workload with a GL_TIME_ELAPSED query
+	void BeginGPUScope(GPU_SCOPE scope);
+	void EndGPUScope(GPU_SCOPE scope);
+
+	// counters incremented on the render path - static so
+	// the managers do not need a profiler reference
+	static void CountDrawCall();
+	static void CountUniformUpload();
+	static void CountElidedUniform();
+	// called by the replaced global allocation operators for
+	// every heap allocation on any thread - the steady-state
+	// render path is supposed to keep this at zero
+	static void CountHeapAllocation();
+	// called by the frame pacer when a frame overran the
+	// display refresh period while vsync was on
+	static void CountMissedVsync();
+
+private:
+	// double buffered timer query objects per scope - the
+	// query issued in one frame is read back the next frame
+	GLuint m_gpuQueries[TOTAL_GPU_SCOPES][2];
+	// was a query actually issued for the scope and parity
+	bool m_queryIssued[TOTAL_GPU_SCOPES][2];
+	// which half of the query double buffer the current
+	// frame writes into
+	int m_frameParity;
+	// has Initialize() created the query objects
+	bool m_bInitialized;
+
+	// CPU timestamp taken in BeginFrame()
+	std::chrono::steady_clock::time_point m_frameStartTime;
+
+	// history ring of the last FrameHistorySize frames
+	FRAME_STATS m_frameHistory[FrameHistorySize];
+	// total number of completed frames
+	long long m_frameCount;
+
+	// render path counters for the current frame
+	static int s_drawCalls;
+	static int s_uniformUploads;
+	static int s_elidedUniforms;
+	// heap allocation counter - atomic because allocations
+	// can come from the worker threads as well
+	static std::atomic<int> s_heapAllocations;
+	static int s_missedVsyncs;
+
+	// average the history ring and print the statistics
+	void DumpStats();
+};
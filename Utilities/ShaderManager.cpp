@@ -0,0 +1,898 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadermanager.cpp
+// ============
+// manage the loading, compiling, linking of GLSL shader programs, along
+// with the setting of uniform values into the active shader program
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderManager.h"
+#include "FrameProfiler.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Namespace for declaring global variables
+namespace
+{
+	// the program binary cache file written next to the
+	// executable, and the magic value at the start of it
+	const char* g_ProgramCacheFile = "shader_program.bin";
+	const uint32_t g_ProgramCacheMagic = 0x53504243; // "SPBC"
+	// bumped when the cache layout changes - version 2 holds
+	// one binary per program variant
+	const uint32_t g_ProgramCacheVersion = 2;
+	// sanity cap on the cache entry count when reading the file
+	const uint32_t g_MaxCachedPrograms = 64;
+
+	// the light count baked into the lit variant until the
+	// scene declares its active count, and the size of the
+	// uploaded light array it can never exceed
+	const int g_DefaultLightCount = 4;
+	const int g_MaxLightCount = 4;
+}
+
+/***********************************************************
+ *  ShaderManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderManager::ShaderManager()
+{
+	ID = 0;
+	for (int variant = 0; variant < TOTAL_SHADER_VARIANTS; variant++)
+	{
+		m_variantIDs[variant] = 0;
+		m_variantHashes[variant] = 0;
+	}
+	// the unlit variant stays active until the scene lighting
+	// has been set up
+	m_activeVariant = SHADER_VARIANT_UNLIT;
+	m_activeLightCount = g_DefaultLightCount;
+	m_bCacheDirty = false;
+}
+
+/***********************************************************
+ *  ~ShaderManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderManager::~ShaderManager()
+{
+	// free the compiled shader program variants
+	for (int variant = 0; variant < TOTAL_SHADER_VARIANTS; variant++)
+	{
+		if (0 != m_variantIDs[variant])
+		{
+			glDeleteProgram(m_variantIDs[variant]);
+			m_variantIDs[variant] = 0;
+		}
+	}
+	ID = 0;
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the GLSL shader code
+ *  from the passed in files, then compiling and linking
+ *  every program variant from those sources.
+ ***********************************************************/
+void ShaderManager::LoadShaders(const char* vtxShaderPath, const char* fragShaderPath)
+{
+	// 1. retrieve the vertex/fragment source code from the file paths
+	std::ifstream vShaderFile;
+	std::ifstream fShaderFile;
+
+	// ensure ifstream objects can throw exceptions
+	vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	try
+	{
+		// open the GLSL shader code files
+		vShaderFile.open(vtxShaderPath);
+		fShaderFile.open(fragShaderPath);
+		std::stringstream vShaderStream, fShaderStream;
+		// read the file buffer contents into streams
+		vShaderStream << vShaderFile.rdbuf();
+		fShaderStream << fShaderFile.rdbuf();
+		// close the file handlers
+		vShaderFile.close();
+		fShaderFile.close();
+		// convert the streams into strings - the sources are
+		// kept so the lit variant can be rebuilt later when
+		// the active light count changes
+		m_vertexSource = vShaderStream.str();
+		m_fragmentSource = fShaderStream.str();
+	}
+	catch (std::ifstream::failure& e)
+	{
+		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+	}
+
+	// 2. read the program binary cache from an earlier launch
+	// into memory - the cache is keyed on a hash of the
+	// specialized sources and the driver version, so any
+	// change to either falls back to a full compile
+	ReadProgramCache();
+
+	// 3. build every program variant - cached binaries are
+	// revived where the hash matches, the rest compile from
+	// source
+	m_bCacheDirty = false;
+	for (int variant = 0; variant < TOTAL_SHADER_VARIANTS; variant++)
+	{
+		m_variantIDs[variant] = CompileVariantProgram((SHADER_VARIANT)variant);
+	}
+
+	// write the refreshed cache out when anything compiled anew
+	if (m_bCacheDirty)
+	{
+		SaveProgramCache();
+	}
+
+	// activate the starting variant
+	ID = m_variantIDs[m_activeVariant];
+
+	// 4. build the uniform location table once so uniform sets
+	// do not need to resolve name strings through the driver.
+	// All per-frame state lives in buffer blocks with explicit
+	// bindings shared by every variant, so the table built on
+	// the active program covers the shipped shaders
+	BuildUniformTable();
+}
+
+/***********************************************************
+ *  BuildVariantDefines()
+ *
+ *  This method is used for building the preprocessor define
+ *  block that specializes the shader sources into the passed
+ *  in program variant.
+ ***********************************************************/
+std::string ShaderManager::BuildVariantDefines(SHADER_VARIANT variant)
+{
+	std::ostringstream defines;
+
+	switch (variant)
+	{
+	case SHADER_VARIANT_UNLIT:
+		defines << "#define LIGHTING 0\n";
+		break;
+	case SHADER_VARIANT_LIT:
+		defines << "#define LIGHTING 1\n";
+		defines << "#define LIGHT_COUNT " << m_activeLightCount << "\n";
+		break;
+	case SHADER_VARIANT_DEPTH_ONLY:
+		defines << "#define DEPTH_ONLY 1\n";
+		break;
+	default:
+		break;
+	}
+
+	return(defines.str());
+}
+
+/***********************************************************
+ *  InjectVariantDefines()
+ *
+ *  This method is used for inserting the variant define
+ *  block into a shader source.  GLSL requires #version to
+ *  be the first statement, so the block lands directly
+ *  after that line.
+ ***********************************************************/
+std::string ShaderManager::InjectVariantDefines(
+	const std::string& source,
+	const std::string& defines)
+{
+	size_t versionPos = source.find("#version");
+	if (versionPos == std::string::npos)
+	{
+		return(defines + source);
+	}
+
+	size_t lineEnd = source.find('\n', versionPos);
+	if (lineEnd == std::string::npos)
+	{
+		return(source + "\n" + defines);
+	}
+
+	std::string result = source.substr(0, lineEnd + 1);
+	result += defines;
+	result += source.substr(lineEnd + 1);
+	return(result);
+}
+
+/***********************************************************
+ *  CompileVariantProgram()
+ *
+ *  This method is used for building one program variant
+ *  from the loaded shader sources.  A cached binary is
+ *  revived when one matching the specialized sources and
+ *  the driver exists, otherwise the sources are compiled
+ *  and linked, and the cache is marked stale.
+ ***********************************************************/
+GLuint ShaderManager::CompileVariantProgram(SHADER_VARIANT variant)
+{
+	// specialize the sources with the injected define block
+	std::string defines = BuildVariantDefines(variant);
+	std::string vertexCode = InjectVariantDefines(m_vertexSource, defines);
+	std::string fragmentCode = InjectVariantDefines(m_fragmentSource, defines);
+	const char* vShaderCode = vertexCode.c_str();
+	const char* fShaderCode = fragmentCode.c_str();
+
+	// try to revive a cached binary for the specialized sources
+	uint64_t sourceHash = HashProgramSources(vertexCode, fragmentCode);
+	m_variantHashes[variant] = sourceHash;
+	GLuint programID = 0;
+	if (TryLoadProgramBinary(sourceHash, programID))
+	{
+		return(programID);
+	}
+
+	// compile the specialized shader code
+	unsigned int vertex, fragment;
+	// vertex shader
+	vertex = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertex, 1, &vShaderCode, NULL);
+	glCompileShader(vertex);
+	checkCompileErrors(vertex, "VERTEX");
+	// fragment Shader
+	fragment = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragment, 1, &fShaderCode, NULL);
+	glCompileShader(fragment);
+	checkCompileErrors(fragment, "FRAGMENT");
+	// link the compiled shaders into the shader program
+	programID = glCreateProgram();
+	glAttachShader(programID, vertex);
+	glAttachShader(programID, fragment);
+	// ask the driver to keep the binary retrievable so it
+	// can be written into the cache after linking
+	glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(programID);
+	checkCompileErrors(programID, "PROGRAM");
+	// delete the shaders as they're linked into the program
+	// and are no longer needed
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+
+	// the cache file no longer covers every variant
+	m_bCacheDirty = true;
+
+	return(programID);
+}
+
+/***********************************************************
+ *  HashProgramSources()
+ *
+ *  This method is used for hashing the shader sources
+ *  together with the driver version strings into the key
+ *  for the program binary cache.  A driver update or any
+ *  source edit produces a different key, which invalidates
+ *  the cached binary.
+ ***********************************************************/
+uint64_t ShaderManager::HashProgramSources(
+	const std::string& vertexCode,
+	const std::string& fragmentCode)
+{
+	// FNV-1a over the sources and the driver identification
+	uint64_t hash = 14695981039346656037ULL;
+	const std::string* sources[2] = { &vertexCode, &fragmentCode };
+
+	for (int i = 0; i < 2; i++)
+	{
+		for (size_t j = 0; j < sources[i]->size(); j++)
+		{
+			hash ^= (uint64_t)(unsigned char)(*sources[i])[j];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	const char* versionString = (const char*)glGetString(GL_VERSION);
+	const char* rendererString = (const char*)glGetString(GL_RENDERER);
+	const char* driverStrings[2] = { versionString, rendererString };
+	for (int i = 0; i < 2; i++)
+	{
+		if (NULL != driverStrings[i])
+		{
+			for (const char* c = driverStrings[i]; *c != '\0'; c++)
+			{
+				hash ^= (uint64_t)(unsigned char)*c;
+				hash *= 1099511628211ULL;
+			}
+		}
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  ReadProgramCache()
+ *
+ *  This method is used for reading the program binary cache
+ *  file written by an earlier launch into the in-memory
+ *  cache.  A malformed or outdated file is ignored and every
+ *  variant compiles from source.
+ ***********************************************************/
+void ShaderManager::ReadProgramCache()
+{
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t programCount = 0;
+	GLint numBinaryFormats = 0;
+
+	m_cachedBinaries.clear();
+
+	// the driver has to support at least one binary format
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+	if (numBinaryFormats <= 0)
+	{
+		return;
+	}
+
+	std::ifstream cacheFile(g_ProgramCacheFile, std::ios::binary);
+	if (!cacheFile.is_open())
+	{
+		return;
+	}
+
+	cacheFile.read((char*)&magic, sizeof(magic));
+	cacheFile.read((char*)&version, sizeof(version));
+	cacheFile.read((char*)&programCount, sizeof(programCount));
+	if (!cacheFile || (magic != g_ProgramCacheMagic) ||
+		(version != g_ProgramCacheVersion) ||
+		(programCount == 0) || (programCount > g_MaxCachedPrograms))
+	{
+		return;
+	}
+
+	for (uint32_t i = 0; i < programCount; i++)
+	{
+		uint64_t cachedHash = 0;
+		GLenum binaryFormat = 0;
+		uint32_t binaryLength = 0;
+
+		cacheFile.read((char*)&cachedHash, sizeof(cachedHash));
+		cacheFile.read((char*)&binaryFormat, sizeof(binaryFormat));
+		cacheFile.read((char*)&binaryLength, sizeof(binaryLength));
+		if (!cacheFile || (binaryLength == 0))
+		{
+			m_cachedBinaries.clear();
+			return;
+		}
+
+		CACHED_BINARY entry;
+		entry.binaryFormat = binaryFormat;
+		entry.data.resize(binaryLength);
+		cacheFile.read(entry.data.data(), binaryLength);
+		if (!cacheFile)
+		{
+			m_cachedBinaries.clear();
+			return;
+		}
+
+		m_cachedBinaries[cachedHash] = entry;
+	}
+}
+
+/***********************************************************
+ *  TryLoadProgramBinary()
+ *
+ *  This method is used for reviving a cached program binary
+ *  matching the passed in source hash.  Returns true only
+ *  when a cache entry exists and the driver accepts the
+ *  binary, otherwise the caller falls back to compiling
+ *  from source.
+ ***********************************************************/
+bool ShaderManager::TryLoadProgramBinary(uint64_t sourceHash, GLuint& programID)
+{
+	GLint linkStatus = GL_FALSE;
+
+	std::unordered_map<uint64_t, CACHED_BINARY>::iterator iter =
+		m_cachedBinaries.find(sourceHash);
+	if (iter == m_cachedBinaries.end())
+	{
+		return(false);
+	}
+
+	// hand the cached binary to the driver - a driver update
+	// can still reject it even when the hash matched
+	const CACHED_BINARY& entry = iter->second;
+	programID = glCreateProgram();
+	glProgramBinary(programID, entry.binaryFormat,
+		entry.data.data(), (GLsizei)entry.data.size());
+	glGetProgramiv(programID, GL_LINK_STATUS, &linkStatus);
+	if (linkStatus != GL_TRUE)
+	{
+		glDeleteProgram(programID);
+		programID = 0;
+		return(false);
+	}
+
+	std::cout << "INFO: Shader program variant loaded from binary cache" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveProgramCache()
+ *
+ *  This method is used for retrieving the linked variant
+ *  binaries from the driver, merging them into the in-memory
+ *  cache and writing the whole cache file out for the next
+ *  launch.
+ ***********************************************************/
+void ShaderManager::SaveProgramCache()
+{
+	GLint numBinaryFormats = 0;
+
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+	if (numBinaryFormats <= 0)
+	{
+		return;
+	}
+
+	// merge the live variant binaries into the cache - earlier
+	// entries for other specializations are kept so they do
+	// not compile again on a later launch
+	for (int variant = 0; variant < TOTAL_SHADER_VARIANTS; variant++)
+	{
+		GLint binaryLength = 0;
+		GLsizei writtenLength = 0;
+
+		if (0 == m_variantIDs[variant])
+		{
+			continue;
+		}
+
+		glGetProgramiv(m_variantIDs[variant], GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+		if (binaryLength <= 0)
+		{
+			continue;
+		}
+
+		CACHED_BINARY entry;
+		entry.binaryFormat = 0;
+		entry.data.resize(binaryLength);
+		glGetProgramBinary(m_variantIDs[variant], binaryLength, &writtenLength,
+			&entry.binaryFormat, entry.data.data());
+		if (writtenLength <= 0)
+		{
+			continue;
+		}
+		entry.data.resize(writtenLength);
+
+		m_cachedBinaries[m_variantHashes[variant]] = entry;
+	}
+
+	if (m_cachedBinaries.empty())
+	{
+		return;
+	}
+
+	std::ofstream cacheFile(g_ProgramCacheFile, std::ios::binary);
+	if (!cacheFile.is_open())
+	{
+		std::cout << "ERROR: Could not write shader binary cache file" << std::endl;
+		return;
+	}
+
+	uint32_t magic = g_ProgramCacheMagic;
+	uint32_t version = g_ProgramCacheVersion;
+	uint32_t programCount = (uint32_t)m_cachedBinaries.size();
+	cacheFile.write((const char*)&magic, sizeof(magic));
+	cacheFile.write((const char*)&version, sizeof(version));
+	cacheFile.write((const char*)&programCount, sizeof(programCount));
+
+	std::unordered_map<uint64_t, CACHED_BINARY>::const_iterator iter;
+	for (iter = m_cachedBinaries.begin(); iter != m_cachedBinaries.end(); ++iter)
+	{
+		uint64_t cachedHash = iter->first;
+		GLenum binaryFormat = iter->second.binaryFormat;
+		uint32_t binaryLength = (uint32_t)iter->second.data.size();
+		cacheFile.write((const char*)&cachedHash, sizeof(cachedHash));
+		cacheFile.write((const char*)&binaryFormat, sizeof(binaryFormat));
+		cacheFile.write((const char*)&binaryLength, sizeof(binaryLength));
+		cacheFile.write(iter->second.data.data(), binaryLength);
+	}
+}
+
+/***********************************************************
+ *  use()
+ *
+ *  This method is used for activating the compiled shader
+ *  program for rendering.
+ ***********************************************************/
+void ShaderManager::use()
+{
+	glUseProgram(ID);
+}
+
+/***********************************************************
+ *  SelectVariant()
+ *
+ *  This method is used for making the passed in program
+ *  variant the active program.  The per-frame camera state
+ *  and all of the scene buffers attach through explicit
+ *  binding points shared by every variant, so switching
+ *  programs mid-frame uploads nothing.
+ ***********************************************************/
+void ShaderManager::SelectVariant(SHADER_VARIANT variant)
+{
+	if ((variant < 0) || (variant >= TOTAL_SHADER_VARIANTS))
+	{
+		return;
+	}
+
+	m_activeVariant = variant;
+	// before LoadShaders() has run only the selection is
+	// recorded - the variant becomes active once it exists
+	if (0 != m_variantIDs[variant])
+	{
+		ID = m_variantIDs[variant];
+		glUseProgram(ID);
+	}
+}
+
+/***********************************************************
+ *  SetActiveLightCount()
+ *
+ *  This method is used for baking the number of active
+ *  light sources into the lit variant.  When the count
+ *  changes after the shaders were loaded, the lit variant
+ *  is rebuilt with the new loop bound - the in-memory
+ *  binary cache usually makes that a revive, not a compile.
+ ***********************************************************/
+void ShaderManager::SetActiveLightCount(int lightCount)
+{
+	if (lightCount < 1)
+	{
+		lightCount = 1;
+	}
+	if (lightCount > g_MaxLightCount)
+	{
+		lightCount = g_MaxLightCount;
+	}
+	if (lightCount == m_activeLightCount)
+	{
+		return;
+	}
+
+	m_activeLightCount = lightCount;
+	if (m_vertexSource.empty())
+	{
+		// the shaders are not loaded yet - the count is baked
+		// in when LoadShaders() builds the variants
+		return;
+	}
+
+	// rebuild the lit variant with the new baked loop bound
+	if (0 != m_variantIDs[SHADER_VARIANT_LIT])
+	{
+		glDeleteProgram(m_variantIDs[SHADER_VARIANT_LIT]);
+		m_variantIDs[SHADER_VARIANT_LIT] = 0;
+	}
+	m_bCacheDirty = false;
+	m_variantIDs[SHADER_VARIANT_LIT] = CompileVariantProgram(SHADER_VARIANT_LIT);
+	if (m_bCacheDirty)
+	{
+		SaveProgramCache();
+	}
+
+	// refresh the active program when the lit variant was it
+	if (m_activeVariant == SHADER_VARIANT_LIT)
+	{
+		ID = m_variantIDs[SHADER_VARIANT_LIT];
+		glUseProgram(ID);
+	}
+}
+
+/***********************************************************
+ *  BuildUniformTable()
+ *
+ *  This method is used for enumerating all of the active
+ *  uniforms in the linked shader program and storing the
+ *  GL locations into a table indexed by integer handle.
+ ***********************************************************/
+void ShaderManager::BuildUniformTable()
+{
+	// clear out any table from a previously loaded program
+	m_uniformHandles.clear();
+	m_uniformLocations.clear();
+	m_uniformShadows.clear();
+
+	GLint uniformCount = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+	GLint maxNameLength = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+	if (maxNameLength <= 0)
+	{
+		maxNameLength = 256;
+	}
+	std::vector<char> nameBuffer(maxNameLength);
+
+	// query each active uniform and record its location -
+	// array uniforms are reported with an "[0]" suffix on
+	// the first element, each element is registered separately
+	for (GLint i = 0; i < uniformCount; i++)
+	{
+		GLsizei nameLength = 0;
+		GLint arraySize = 0;
+		GLenum type = GL_NONE;
+		glGetActiveUniform(ID, i, maxNameLength, &nameLength,
+			&arraySize, &type, nameBuffer.data());
+
+		std::string name(nameBuffer.data(), nameLength);
+		// strip the "[0]" suffix from array uniform names
+		size_t bracketPos = name.find("[0]");
+		if (bracketPos != std::string::npos)
+		{
+			name = name.substr(0, bracketPos);
+		}
+
+		GLint location = glGetUniformLocation(ID, name.c_str());
+		if (location >= 0)
+		{
+			m_uniformHandles[name] = (UniformHandle)m_uniformLocations.size();
+			m_uniformLocations.push_back(location);
+		}
+	}
+}
+
+/***********************************************************
+ *  GetUniformHandle()
+ *
+ *  This method is used for resolving a uniform name into
+ *  an integer handle.  The handle stays valid for the life
+ *  of the loaded shader program and can be used with the
+ *  handle-based setter methods on the per-frame path.
+ ***********************************************************/
+ShaderManager::UniformHandle ShaderManager::GetUniformHandle(const std::string& name)
+{
+	std::unordered_map<std::string, UniformHandle>::iterator iter =
+		m_uniformHandles.find(name);
+	if (iter != m_uniformHandles.end())
+	{
+		return(iter->second);
+	}
+
+	// the name was not enumerated at link time (for example a
+	// structure member accessed with a full path) - ask the
+	// driver once and add the result to the table
+	GLint location = glGetUniformLocation(ID, name.c_str());
+	if (location < 0)
+	{
+		return(InvalidUniformHandle);
+	}
+
+	UniformHandle handle = (UniformHandle)m_uniformLocations.size();
+	m_uniformLocations.push_back(location);
+	m_uniformHandles[name] = handle;
+	return(handle);
+}
+
+/***********************************************************
+ *  GetUniformLocation()
+ *
+ *  This method is used for looking up the GL location for
+ *  the passed in uniform name through the location table.
+ ***********************************************************/
+GLint ShaderManager::GetUniformLocation(const std::string& name)
+{
+	UniformHandle handle = GetUniformHandle(name);
+	if (handle == InvalidUniformHandle)
+	{
+		return(-1);
+	}
+	return(m_uniformLocations[handle]);
+}
+
+/***********************************************************
+ *  ShadowCheck()
+ *
+ *  This method is used for comparing a uniform value that
+ *  is about to be written against the shadow copy of the
+ *  last written value.  Returns true when the write can be
+ *  dropped because the value is unchanged, otherwise the
+ *  new value is stored into the shadow.  The elided writes
+ *  are counted through the frame instrumentation surface.
+ ***********************************************************/
+bool ShaderManager::ShadowCheck(UniformHandle handle, const void* data, size_t size)
+{
+	// the location table can grow after late handle
+	// resolution - keep the shadow table in step with it
+	if ((size_t)handle >= m_uniformShadows.size())
+	{
+		m_uniformShadows.resize(m_uniformLocations.size());
+	}
+
+	UNIFORM_SHADOW& shadow = m_uniformShadows[handle];
+	if (shadow.bValid && (shadow.size == size) &&
+		(memcmp(shadow.data, data, size) == 0))
+	{
+		FrameProfiler::CountElidedUniform();
+		return(true);
+	}
+
+	memcpy(shadow.data, data, size);
+	shadow.size = size;
+	shadow.bValid = true;
+	return(false);
+}
+
+// ------------------------------------------------------------------------
+// utility uniform functions - name-resolved versions, these resolve the
+// name to a handle and delegate to the handle-resolved fast path below
+// ------------------------------------------------------------------------
+void ShaderManager::setBoolValue(const std::string& name, bool value)
+{
+	setBoolValue(GetUniformHandle(name), value);
+}
+void ShaderManager::setIntValue(const std::string& name, int value)
+{
+	setIntValue(GetUniformHandle(name), value);
+}
+void ShaderManager::setSampler2DValue(const std::string& name, int value)
+{
+	setSampler2DValue(GetUniformHandle(name), value);
+}
+void ShaderManager::setFloatValue(const std::string& name, float value)
+{
+	setFloatValue(GetUniformHandle(name), value);
+}
+void ShaderManager::setVec2Value(const std::string& name, const glm::vec2& value)
+{
+	setVec2Value(GetUniformHandle(name), value);
+}
+void ShaderManager::setVec2Value(const std::string& name, float x, float y)
+{
+	setVec2Value(GetUniformHandle(name), glm::vec2(x, y));
+}
+void ShaderManager::setVec3Value(const std::string& name, const glm::vec3& value)
+{
+	setVec3Value(GetUniformHandle(name), value);
+}
+void ShaderManager::setVec3Value(const std::string& name, float x, float y, float z)
+{
+	setVec3Value(GetUniformHandle(name), glm::vec3(x, y, z));
+}
+void ShaderManager::setVec4Value(const std::string& name, const glm::vec4& value)
+{
+	setVec4Value(GetUniformHandle(name), value);
+}
+void ShaderManager::setVec4Value(const std::string& name, float x, float y, float z, float w)
+{
+	setVec4Value(GetUniformHandle(name), glm::vec4(x, y, z, w));
+}
+void ShaderManager::setMat2Value(const std::string& name, const glm::mat2& mat)
+{
+	FrameProfiler::CountUniformUpload();
+	glUniformMatrix2fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+}
+void ShaderManager::setMat3Value(const std::string& name, const glm::mat3& mat)
+{
+	FrameProfiler::CountUniformUpload();
+	glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+}
+void ShaderManager::setMat4Value(const std::string& name, const glm::mat4& mat)
+{
+	setMat4Value(GetUniformHandle(name), mat);
+}
+
+// ------------------------------------------------------------------------
+// utility uniform functions - handle-resolved fast path, the handle is
+// an index into the location table so no string work happens per call,
+// and writes matching the shadow copy of the last value are dropped
+// ------------------------------------------------------------------------
+void ShaderManager::setBoolValue(UniformHandle handle, bool value)
+{
+	int intValue = (int)value;
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, &intValue, sizeof(intValue)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform1i(m_uniformLocations[handle], intValue);
+	}
+}
+void ShaderManager::setIntValue(UniformHandle handle, int value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, &value, sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform1i(m_uniformLocations[handle], value);
+	}
+}
+void ShaderManager::setSampler2DValue(UniformHandle handle, int value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, &value, sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform1i(m_uniformLocations[handle], value);
+	}
+}
+void ShaderManager::setFloatValue(UniformHandle handle, float value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, &value, sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform1f(m_uniformLocations[handle], value);
+	}
+}
+void ShaderManager::setVec2Value(UniformHandle handle, const glm::vec2& value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, glm::value_ptr(value), sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform2fv(m_uniformLocations[handle], 1, glm::value_ptr(value));
+	}
+}
+void ShaderManager::setVec3Value(UniformHandle handle, const glm::vec3& value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, glm::value_ptr(value), sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform3fv(m_uniformLocations[handle], 1, glm::value_ptr(value));
+	}
+}
+void ShaderManager::setVec4Value(UniformHandle handle, const glm::vec4& value)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, glm::value_ptr(value), sizeof(value)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniform4fv(m_uniformLocations[handle], 1, glm::value_ptr(value));
+	}
+}
+void ShaderManager::setMat4Value(UniformHandle handle, const glm::mat4& mat)
+{
+	if ((handle != InvalidUniformHandle) &&
+		!ShadowCheck(handle, glm::value_ptr(mat), sizeof(mat)))
+	{
+		FrameProfiler::CountUniformUpload();
+		glUniformMatrix4fv(m_uniformLocations[handle], 1, GL_FALSE, glm::value_ptr(mat));
+	}
+}
+
+/***********************************************************
+ *  checkCompileErrors()
+ *
+ *  This method is used for checking the results of the
+ *  shader compile and link operations, any errors are
+ *  output to the console window.
+ ***********************************************************/
+void ShaderManager::checkCompileErrors(unsigned int shader, std::string type)
+{
+	int success;
+	char infoLog[1024];
+	if (type != "PROGRAM")
+	{
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+			std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: " << type << "\n"
+				<< infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+		}
+	}
+	else
+	{
+		glGetProgramiv(shader, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+			std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n"
+				<< infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
+		}
+	}
+}
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadermanager.h
+// ============
+// manage the loading, compiling, linking of GLSL shader programs, along
+// with the setting of uniform values into the active shader program
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************
+ *  ShaderManager
+ *
+ *  This class contains the code for loading the vertex and
+ *  fragment shader files into a small matrix of compiled GLSL
+ *  program variants, and for setting named uniform values into
+ *  the active program.
+ *
+ *  The variants specialize the shaders at compile time - the
+ *  lit variant bakes the active light count into the light
+ *  loop bound, the unlit variant drops the lighting path
+ *  entirely, and the depth-only variant has an empty fragment
+ *  stage for the depth pre-pass.  A define block injected
+ *  after the #version line selects the variant; the runtime
+ *  uniform branches the defines replace are gone from the
+ *  shader sources.  All per-frame camera state lives in a
+ *  uniform buffer shared by every variant, so switching
+ *  variants mid-frame uploads nothing.
+ *
+ *  Uniform values can be set either by name, or - for code
+ *  on the per-frame path - by an integer UniformHandle that
+ *  is resolved once and then indexes directly into a location
+ *  table built at LoadShaders() time.  The handle path avoids
+ *  the per-call glGetUniformLocation() string resolution that
+ *  is measurable on low-end GPU drivers.
+ *
+ *  Every uniform write is checked against a shadow copy of
+ *  the last written value and silently dropped when the
+ *  value has not changed - the elided writes are counted
+ *  through the frame instrumentation surface.
+ ***********************************************************/
+class ShaderManager
+{
+public:
+	// constructor
+	ShaderManager();
+	// destructor
+	~ShaderManager();
+
+	// integer handle for a named uniform - an index into the
+	// uniform location table that is built when the shader
+	// program is linked
+	typedef int UniformHandle;
+	// returned when a uniform name is not found in the program
+	static const UniformHandle InvalidUniformHandle = -1;
+
+	// the compile-time specialized program variants built
+	// from the loaded shader sources
+	enum SHADER_VARIANT
+	{
+		// no lighting path at all - the active variant until
+		// the scene lighting has been set up
+		SHADER_VARIANT_UNLIT,
+		// full lighting with the active light count baked
+		// into the light loop bound
+		SHADER_VARIANT_LIT,
+		// empty fragment stage - used by the depth pre-pass
+		SHADER_VARIANT_DEPTH_ONLY,
+		TOTAL_SHADER_VARIANTS
+	};
+
+	// the active shader program ID
+	GLuint ID;
+
+	// load the vertex and fragment shader code from the
+	// GLSL files, then compile and link every program variant -
+	// cached program binaries are used instead of compiling
+	// where one matching the sources and driver exists
+	void LoadShaders(const char* vtxShaderPath, const char* fragShaderPath);
+
+	// activate the shader program for rendering
+	void use();
+
+	// make the passed in program variant the active program
+	void SelectVariant(SHADER_VARIANT variant);
+
+	// bake the number of active light sources into the lit
+	// variant - rebuilds that variant when the count changes
+	void SetActiveLightCount(int lightCount);
+
+	// resolve a uniform name to an integer handle - call once
+	// during scene preparation, then use the handle overloads
+	// below on the per-frame path
+	UniformHandle GetUniformHandle(const std::string& name);
+
+	// utility uniform functions - name-resolved versions
+	void setBoolValue(const std::string& name, bool value);
+	void setIntValue(const std::string& name, int value);
+	void setSampler2DValue(const std::string& name, int value);
+	void setFloatValue(const std::string& name, float value);
+	void setVec2Value(const std::string& name, const glm::vec2& value);
+	void setVec2Value(const std::string& name, float x, float y);
+	void setVec3Value(const std::string& name, const glm::vec3& value);
+	void setVec3Value(const std::string& name, float x, float y, float z);
+	void setVec4Value(const std::string& name, const glm::vec4& value);
+	void setVec4Value(const std::string& name, float x, float y, float z, float w);
+	void setMat2Value(const std::string& name, const glm::mat2& mat);
+	void setMat3Value(const std::string& name, const glm::mat3& mat);
+	void setMat4Value(const std::string& name, const glm::mat4& mat);
+
+	// utility uniform functions - handle-resolved fast path
+	void setBoolValue(UniformHandle handle, bool value);
+	void setIntValue(UniformHandle handle, int value);
+	void setSampler2DValue(UniformHandle handle, int value);
+	void setFloatValue(UniformHandle handle, float value);
+	void setVec2Value(UniformHandle handle, const glm::vec2& value);
+	void setVec3Value(UniformHandle handle, const glm::vec3& value);
+	void setVec4Value(UniformHandle handle, const glm::vec4& value);
+	void setMat4Value(UniformHandle handle, const glm::mat4& mat);
+
+private:
+	// one program binary held in the in-memory cache, keyed
+	// by the hash of the specialized sources that produced it
+	struct CACHED_BINARY
+	{
+		GLenum binaryFormat;
+		std::vector<char> data;
+	};
+
+	// build the injected define block for a program variant
+	std::string BuildVariantDefines(SHADER_VARIANT variant);
+	// insert the define block into a shader source directly
+	// after its #version line
+	static std::string InjectVariantDefines(
+		const std::string& source,
+		const std::string& defines);
+	// compile and link one program variant from the loaded
+	// sources, or revive it from the binary cache - returns
+	// the linked program ID
+	GLuint CompileVariantProgram(SHADER_VARIANT variant);
+
+	// hash the shader sources together with the driver
+	// version strings to key the program binary cache
+	static uint64_t HashProgramSources(
+		const std::string& vertexCode,
+		const std::string& fragmentCode);
+	// read the program binary cache file written by an earlier
+	// launch into the in-memory cache
+	void ReadProgramCache();
+	// try to revive a cached program binary matching the hash -
+	// returns true when the cached program linked successfully
+	bool TryLoadProgramBinary(uint64_t sourceHash, GLuint& programID);
+	// retrieve the linked variant binaries from the driver and
+	// write the whole cache file out for the next launch
+	void SaveProgramCache();
+
+	// build the uniform location table for the linked program
+	void BuildUniformTable();
+	// look up the GL location for a uniform name, using the
+	// table built at LoadShaders() time
+	GLint GetUniformLocation(const std::string& name);
+
+	// shadow copy of the last value written to a uniform -
+	// large enough for a mat4, the biggest cached type
+	struct UNIFORM_SHADOW
+	{
+		unsigned char data[64];
+		size_t size;
+		bool bValid;
+	};
+
+	// compare the passed in value against the shadow copy
+	// for the handle - returns true when the write can be
+	// dropped because the value is already set, otherwise
+	// stores the new value into the shadow
+	bool ShadowCheck(UniformHandle handle, const void* data, size_t size);
+
+	// the loaded shader sources - kept so the lit variant can
+	// be rebuilt when the active light count changes
+	std::string m_vertexSource;
+	std::string m_fragmentSource;
+	// the linked program IDs and source hashes per variant
+	GLuint m_variantIDs[TOTAL_SHADER_VARIANTS];
+	uint64_t m_variantHashes[TOTAL_SHADER_VARIANTS];
+	// the currently active program variant
+	SHADER_VARIANT m_activeVariant;
+	// the light count baked into the lit variant
+	int m_activeLightCount;
+	// program binaries from the cache file, kept in memory so
+	// a lit variant rebuild can still hit the cache
+	std::unordered_map<uint64_t, CACHED_BINARY> m_cachedBinaries;
+	// raised when a variant compiled from source instead of
+	// reviving from the cache - the cache file is stale
+	bool m_bCacheDirty;
+
+	// uniform name to handle mapping, built at link time
+	std::unordered_map<std::string, UniformHandle> m_uniformHandles;
+	// uniform GL locations indexed by handle
+	std::vector<GLint> m_uniformLocations;
+	// last written uniform values indexed by handle - writes
+	// matching the shadow copy are silently dropped
+	std::vector<UNIFORM_SHADOW> m_uniformShadows;
+
+	// check for any shader compile or link errors
+	void checkCompileErrors(unsigned int shader, std::string type);
+};
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// startupprofiler.cpp
+// ============
+// measure the startup phases from process launch to the first rendered
+// frame and report them as a boot waterfall
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StartupProfiler.h"
+
+#include <iomanip>
+#include <iostream>
+
+std::vector<StartupProfiler::PHASE_RECORD> StartupProfiler::s_phases;
+std::vector<size_t> StartupProfiler::s_openPhases;
+std::chrono::steady_clock::time_point StartupProfiler::s_launchTime =
+	std::chrono::steady_clock::now();
+
+/***********************************************************
+ *  ElapsedMs()
+ *
+ *  This method returns the milliseconds elapsed since the
+ *  process launch timestamp.
+ ***********************************************************/
+double StartupProfiler::ElapsedMs()
+{
+	return(std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - s_launchTime).count());
+}
+
+/***********************************************************
+ *  BeginPhase()
+ *
+ *  This method records the start of one startup phase.
+ *  Phases may nest - a phase begun before the previous one
+ *  ended is reported indented under it.
+ ***********************************************************/
+void StartupProfiler::BeginPhase(const char* pPhaseName)
+{
+	PHASE_RECORD phase;
+	phase.name = pPhaseName;
+	phase.depth = (int)s_openPhases.size();
+	phase.startMs = ElapsedMs();
+	phase.durationMs = 0.0;
+
+	s_openPhases.push_back(s_phases.size());
+	s_phases.push_back(phase);
+}
+
+/***********************************************************
+ *  EndPhase()
+ *
+ *  This method records the end of the innermost open
+ *  startup phase.
+ ***********************************************************/
+void StartupProfiler::EndPhase()
+{
+	if (s_openPhases.empty())
+	{
+		return;
+	}
+
+	PHASE_RECORD& phase = s_phases[s_openPhases.back()];
+	phase.durationMs = ElapsedMs() - phase.startMs;
+	s_openPhases.pop_back();
+}
+
+/***********************************************************
+ *  ReportWaterfall()
+ *
+ *  This method prints the recorded phases as a boot
+ *  waterfall - one line per phase with its start offset
+ *  from process launch and its duration, nested phases
+ *  indented under their parent - followed by the total
+ *  boot time so far.
+ ***********************************************************/
+void StartupProfiler::ReportWaterfall()
+{
+	std::cout << "INFO: startup waterfall -" << std::endl;
+	for (size_t index = 0; index < s_phases.size(); index++)
+	{
+		const PHASE_RECORD& phase = s_phases[index];
+
+		std::cout << "INFO:   "
+			<< std::fixed << std::setprecision(1)
+			<< std::setw(8) << phase.startMs << "ms  +"
+			<< std::setw(7) << phase.durationMs << "ms  ";
+		for (int depth = 0; depth < phase.depth; depth++)
+		{
+			std::cout << "  ";
+		}
+		std::cout << phase.name << std::endl;
+	}
+	std::cout << "INFO:   total boot time: "
+		<< std::fixed << std::setprecision(1)
+		<< ElapsedMs() << "ms" << std::endl;
+	std::cout.unsetf(std::ios::fixed);
+	std::cout << std::setprecision(6);
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+// startupprofiler.h
+// ============
+// measure the startup phases from process launch to the first rendered
+// frame and report them as a boot waterfall
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  StartupProfiler
+ *
+ *  This class contains the code for timing the startup
+ *  phases - library initialization, shader loading, texture
+ *  loading, mesh generation and scene building.  Phases are
+ *  bracketed with Begin/End calls, may nest, and are
+ *  reported as a waterfall of start offsets and durations
+ *  measured from process launch.  Everything is static so
+ *  the phases that run before any manager exists can be
+ *  recorded without plumbing an object through.
+ ***********************************************************/
+class StartupProfiler
+{
+public:
+	// begin and end one startup phase - phases may nest, the
+	// report indents nested phases under their parent.  Main
+	// thread only
+	static void BeginPhase(const char* pPhaseName);
+	static void EndPhase();
+
+	// print the recorded phases as a boot waterfall and the
+	// total time from process launch
+	static void ReportWaterfall();
+
+private:
+	// one recorded startup phase
+	struct PHASE_RECORD
+	{
+		std::string name;
+		int depth;
+		double startMs;
+		double durationMs;
+	};
+
+	// milliseconds elapsed since process launch
+	static double ElapsedMs();
+
+	// the recorded phases in begin order
+	static std::vector<PHASE_RECORD> s_phases;
+	// indices of the phases begun but not yet ended
+	static std::vector<size_t> s_openPhases;
+	// the process launch timestamp the offsets are measured
+	// from - captured during static initialization
+	static std::chrono::steady_clock::time_point s_launchTime;
+};
@@ -0,0 +1,205 @@
+#version 460 core
+
+// compile-time specialization defines - injected by the
+// shader manager when it builds the program variants, so the
+// lit/unlit decision and the light loop bound are baked in
+// instead of branching on uniforms.  The defaults keep the
+// file compiling standalone
+#ifndef LIGHTING
+#define LIGHTING 1
+#endif
+#ifndef LIGHT_COUNT
+#define LIGHT_COUNT 4
+#endif
+#ifndef DEPTH_ONLY
+#define DEPTH_ONLY 0
+#endif
+
+#if DEPTH_ONLY
+
+// the depth-only variant does no fragment work at all - the
+// depth pre-pass masks the color writes and keeps only the
+// depth test results
+void main()
+{
+}
+
+#else
+
+out vec4 outFragmentColor;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in int fragmentMaterialIndex;
+flat in int fragmentStateIndex;
+
+struct Material
+{
+    float ambientStrength;
+    vec3 ambientColor;
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+};
+
+struct LightSource
+{
+    vec3 position;
+    vec3 ambientColor;
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float focalStrength;
+    float specularIntensity;
+};
+
+// the shader state that used to arrive through per-draw
+// uniform calls - one record per draw batch, selected with
+// the per-instance state index
+struct DrawState
+{
+    vec4 color;
+    vec2 uvScale;
+    vec2 uvOffset;
+    int bUseTexture;
+    int textureSlot;
+};
+
+// the uploaded light array stays this size - LIGHT_COUNT is
+// the baked count of the lights actually in use
+#define TOTAL_LIGHTS 4
+#define TOTAL_MATERIALS 16
+
+// the light sources are uploaded once into a uniform buffer
+// object - they never change during a frame
+layout(std140, binding = 0) uniform LightBlock
+{
+    LightSource lightSources[TOTAL_LIGHTS];
+};
+
+// the material table is uploaded once into a uniform buffer
+// object - per-object material selection is just an index
+layout(std140, binding = 1) uniform MaterialBlock
+{
+    Material materials[TOTAL_MATERIALS];
+};
+
+// the per-draw state table is uploaded once at scene
+// preparation - the frame replays with no uniform traffic
+layout(std430, binding = 2) readonly buffer DrawStateBlock
+{
+    DrawState drawStates[];
+};
+
+// per-frame camera state, shared by every program variant
+// through one uniform buffer
+layout(std140, binding = 3) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+};
+
+// world-to-shadow-map matrices for the static lights - built
+// once when the cached shadow maps are rendered
+layout(std140, binding = 4) uniform ShadowBlock
+{
+    mat4 shadowMatrices[TOTAL_LIGHTS];
+};
+
+// all of the loaded scene textures, bound to consecutive
+// texture units - the per-draw state picks the slot, the
+// state index is uniform across a draw so the indexing is
+// legal
+layout(binding = 0) uniform sampler2D objectTextures[16];
+
+// the cached shadow depth maps, one array layer per light -
+// rendered once at scene preparation, the comparison sampler
+// does the depth test in hardware
+layout(binding = 16) uniform sampler2DArrayShadow shadowMaps;
+
+// depth comparison bias that keeps surfaces from shadowing
+// themselves
+const float shadowDepthBias = 0.0015;
+
+// function prototypes
+vec3 CalcPointLight(LightSource light, Material material, vec3 baseColor, vec3 fragPos, vec3 normal, vec3 viewDir, float shadowFactor);
+float CalcShadowFactor(int lightIndex, vec3 fragPos);
+
+void main()
+{
+    DrawState drawState = drawStates[fragmentStateIndex];
+
+    // resolve the surface base color once - either a sample
+    // from the draw's texture or its flat object color
+    vec4 baseColor;
+    if (drawState.bUseTexture != 0)
+    {
+        baseColor = texture(objectTextures[drawState.textureSlot],
+            fragmentTextureCoordinate * drawState.uvScale + drawState.uvOffset);
+    }
+    else
+    {
+        baseColor = drawState.color;
+    }
+
+#if LIGHTING
+    // properties
+    vec3 normal = normalize(fragmentVertexNormal);
+    vec3 viewDir = normalize(vec3(viewPosition) - fragmentPosition);
+    Material material = materials[fragmentMaterialIndex];
+
+    vec3 phongResult = vec3(0.0f);
+    // calculate the contribution from each of the active light
+    // sources - the loop bound is a compile-time constant so
+    // the compiler can unroll it fully
+    for (int i = 0; i < LIGHT_COUNT; i++)
+    {
+        float shadowFactor = CalcShadowFactor(i, fragmentPosition);
+        phongResult += CalcPointLight(lightSources[i], material, vec3(baseColor), fragmentPosition, normal, viewDir, shadowFactor);
+    }
+
+    outFragmentColor = vec4(phongResult, 1.0);
+#else
+    outFragmentColor = baseColor;
+#endif
+}
+
+// calculates the color when using a point light source -
+// the shadow factor attenuates the directional terms only,
+// the ambient term stays so shadows never go fully black
+vec3 CalcPointLight(LightSource light, Material material, vec3 baseColor, vec3 fragPos, vec3 normal, vec3 viewDir, float shadowFactor)
+{
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), light.focalStrength);
+    // combine results
+    vec3 ambient = light.ambientColor * material.ambientStrength * baseColor;
+    vec3 diffuse = light.diffuseColor * diff * material.diffuseColor * baseColor;
+    vec3 specular = light.specularColor * light.specularIntensity * spec * material.specularColor;
+
+    return (ambient + (diffuse + specular) * shadowFactor);
+}
+
+// samples the light's cached shadow map - 1.0 when the
+// fragment is lit, 0.0 when it is occluded.  The clamp-to-
+// border sampler returns lit for fragments outside the
+// light's frustum
+float CalcShadowFactor(int lightIndex, vec3 fragPos)
+{
+    vec4 shadowCoord = shadowMatrices[lightIndex] * vec4(fragPos, 1.0);
+    vec3 projected = shadowCoord.xyz / shadowCoord.w;
+
+    // fragments beyond the light's far plane are lit
+    if (projected.z > 1.0)
+    {
+        return 1.0;
+    }
+    return texture(shadowMaps,
+        vec4(projected.xy, float(lightIndex), projected.z - shadowDepthBias));
+}
+
+#endif // DEPTH_ONLY
@@ -0,0 +1,56 @@
+#version 460 core
+
+// compile-time specialization defines - injected by the
+// shader manager when it builds the program variants.  The
+// defaults keep the file compiling standalone
+#ifndef DEPTH_ONLY
+#define DEPTH_ONLY 0
+#endif
+
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+// per-instance model matrix - a mat4 attribute occupies
+// locations 3 through 6.  Every draw is instanced now, the
+// single-object case is just an instance count of one
+layout (location = 3) in mat4 inInstanceModel;
+// per-instance index into the material table
+layout (location = 7) in int inInstanceMaterialIndex;
+// per-instance index into the draw state table - it rides
+// with the instances so the indirect commands can be queued
+// in any order each frame
+layout (location = 8) in int inInstanceStateIndex;
+
+// the depth-only variant emits positions and nothing else
+#if !DEPTH_ONLY
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+flat out int fragmentMaterialIndex;
+flat out int fragmentStateIndex;
+#endif
+
+// per-frame camera state, shared by every program variant
+// through one uniform buffer - switching variants needs no
+// uniform re-uploads
+layout(std140, binding = 3) uniform CameraBlock
+{
+    mat4 view;
+    mat4 projection;
+    vec4 viewPosition;
+};
+
+void main()
+{
+   vec3 worldPosition = vec3(inInstanceModel * vec4(inVertexPosition, 1.0));
+
+#if !DEPTH_ONLY
+   fragmentPosition = worldPosition;
+   fragmentVertexNormal = mat3(transpose(inverse(inInstanceModel))) * inVertexNormal;
+   fragmentTextureCoordinate = inTextureCoordinate;
+   fragmentMaterialIndex = inInstanceMaterialIndex;
+   fragmentStateIndex = inInstanceStateIndex;
+#endif
+
+   gl_Position = projection * view * vec4(worldPosition, 1.0);
+}